@@ -73,6 +73,9 @@ ExternalProject_Add(
     INSTALL_COMMAND ${CMAKE_COMMAND} -E copy # ${CMAKE_COMMAND} -E <- Windows, Mac 등 OS 에 구애받지 않도록, copy <- 복사 커맨드
         ${PROJECT_BINARY_DIR}/dep_stb-prefix/src/dep_stb/stb_image.h
         ${DEP_INSTALL_DIR}/include/stb/stb_image.h
+        COMMAND ${CMAKE_COMMAND} -E copy # 프레임 저장용 PNG 인코더
+        ${PROJECT_BINARY_DIR}/dep_stb-prefix/src/dep_stb/stb_image_write.h
+        ${DEP_INSTALL_DIR}/include/stb/stb_image_write.h
     )
 set(DEP_LIST ${DEP_LIST} dep_stb)
 
@@ -0,0 +1,17 @@
+#version 330 core
+// --shader-benchmark 용 permutation. VARIANT 값마다 소스가 달라져 각각 따로 컴파일된다
+#ifndef VARIANT
+#define VARIANT 0
+#endif
+in vec3 normal;
+in vec2 texCoord;
+out vec4 fragColor;
+
+uniform sampler2D tex;
+
+void main() {
+    vec4 color = texture(tex, texCoord);
+    for (int i = 0; i < VARIANT % 8 + 1; i++)
+        color.rgb = sqrt(color.rgb * (1.0 + float(VARIANT) * 0.0001));
+    fragColor = vec4(color.rgb * (0.5 + 0.5 * normalize(normal).y), color.a);
+}
\ No newline at end of file
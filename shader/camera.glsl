@@ -0,0 +1,6 @@
+// 프레임 단위로 공유하는 카메라 데이터 (UniformBuffer, std140)
+layout (std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+};
@@ -1,11 +1,42 @@
 #version 330 core
-in vec4 vertexColor;
+// 사용할 텍스처 수 (1 또는 2). 지정하지 않으면 2
+#ifndef TEXTURE_COUNT
+#define TEXTURE_COUNT 2
+#endif
+in vec3 normal;
 in vec2 texCoord;
 out vec4 fragColor;
 
 uniform sampler2D tex;
+#if TEXTURE_COUNT > 1
+#ifdef TEXTURE_ARRAY
+// material 이미지를 layer로 쌓은 texture array. ATLAS와 함께 사용
+uniform sampler2DArray tex2;
+#else
 uniform sampler2D tex2;
+#endif
+#endif
+#ifdef ATLAS
+in vec3 atlasCoord;
+#endif
+
+// world 공간의 고정된 방향광
+const vec3 lightDirection = normalize(vec3(0.3, 1.0, 0.5));
 
 void main() {
-    fragColor = texture(tex, texCoord) * 0.8 + texture(tex2, texCoord) * 0.2;
+#if TEXTURE_COUNT > 1
+#if defined(ATLAS) && defined(TEXTURE_ARRAY)
+    vec4 material = texture(tex2, atlasCoord);
+#elif defined(ATLAS)
+    vec4 material = texture(tex2, atlasCoord.xy);
+#else
+    vec4 material = texture(tex2, texCoord);
+#endif
+    vec4 color = texture(tex, texCoord) * 0.8 + material * 0.2;
+#else
+    vec4 color = texture(tex, texCoord);
+#endif
+    // 면 방향이 보이도록 약한 lambert 조명
+    float light = 0.6 + 0.4 * max(dot(normalize(normal), lightDirection), 0.0);
+    fragColor = vec4(color.rgb * light, color.a);
 }
\ No newline at end of file
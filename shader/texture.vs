@@ -1,15 +1,74 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aColor;
+#ifdef PACKED_NORMAL
+// 양자화된 메쉬: octahedral encoding한 normal (snorm16 2개)
+layout (location = 1) in vec2 aNormal;
+#else
+layout (location = 1) in vec3 aNormal;
+#endif
 layout (location = 2) in vec2 aTexCoord;
+#ifdef INSTANCED
+// 인스턴스별 model 행렬. mat4는 location 3, 4, 5, 6을 차지한다
+layout (location = 3) in mat4 aModel;
+#else
+uniform mat4 model;
+#endif
+#ifdef ATLAS
+// 두번째 텍스처(material)의 atlas 영역. xy: uvOffset, zw: uvScale
+#ifdef INSTANCED
+layout (location = 7) in vec4 aUvRect;
+layout (location = 8) in float aLayer;
+#else
+uniform vec4 uvRect;
+uniform float layer;
+#endif
+#endif
 
-uniform mat4 transform;
+#include "camera.glsl"
+// 양자화된 position 복원용 bounding box (float 메쉬는 scale 1, offset 0)
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
 
-out vec4 vertexColor;
+out vec3 normal;
 out vec2 texCoord;
+#ifdef ATLAS
+// xy: atlas 안의 uv, z: texture array layer
+out vec3 atlasCoord;
+#endif
+
+#ifdef PACKED_NORMAL
+// MeshFile의 EncodeOctahedral의 역변환. 아래쪽 반구는 접혀있던 것을 다시 펼친다
+vec3 DecodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(n);
+}
+#endif
 
 void main() {
-    gl_Position = transform * vec4(aPos, 1.0);
-    vertexColor = vec4(aColor, 1.0);
+#ifdef INSTANCED
+    mat4 modelMatrix = aModel;
+#else
+    mat4 modelMatrix = model;
+#endif
+    gl_Position = viewProjection * modelMatrix * vec4(positionOffset + positionScale * aPos, 1.0);
+#ifdef PACKED_NORMAL
+    vec3 objectNormal = DecodeOctahedral(aNormal);
+#else
+    vec3 objectNormal = aNormal;
+#endif
+    // 큐브는 회전 / 균일 크기 변환만 하므로 model 행렬의 회전 부분을 그대로 사용
+    normal = mat3(modelMatrix) * objectNormal;
     texCoord = aTexCoord;
+#ifdef ATLAS
+#ifdef INSTANCED
+    vec4 rect = aUvRect;
+    float atlasLayer = aLayer;
+#else
+    vec4 rect = uvRect;
+    float atlasLayer = layer;
+#endif
+    atlasCoord = vec3(aTexCoord * rect.zw + rect.xy, atlasLayer);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "atlas_packer.h"
+#include <algorithm>
+
+AtlasPackerUPtr AtlasPacker::Create(int width, int height) {
+    auto packer = AtlasPackerUPtr(new AtlasPacker());
+    if (!packer->Init(width, height))
+        return nullptr;
+    return std::move(packer);
+}
+
+bool AtlasPacker::Init(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        SPDLOG_ERROR("invalid atlas size: {}x{}", width, height);
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+    Clear();
+    return true;
+}
+
+void AtlasPacker::Clear() {
+    m_usedArea = 0;
+    m_skyline.clear();
+    m_skyline.push_back({ 0, 0, m_width });
+}
+
+int AtlasPacker::GetUsedHeight() const {
+    int height = 0;
+    for (auto& node : m_skyline)
+        height = std::max(height, node.y);
+    return height;
+}
+
+int AtlasPacker::Fit(size_t node, int width, int height) const {
+    int x = m_skyline[node].x;
+    if (x + width > m_width)
+        return -1;
+    // 덮이는 skyline 중 가장 높은 곳 위에 놓인다
+    int y = 0;
+    int remain = width;
+    for (size_t i = node; remain > 0; i++) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height)
+            return -1;
+        remain -= m_skyline[i].width;
+    }
+    return y;
+}
+
+bool AtlasPacker::Insert(int width, int height, int& x, int& y) {
+    if (width <= 0 || height <= 0)
+        return false;
+
+    // 윗면이 가장 낮은 곳, 같으면 가장 좁은 skyline에 놓기
+    size_t bestNode = m_skyline.size();
+    int bestTop = m_height + 1;
+    int bestWidth = m_width + 1;
+    for (size_t i = 0; i < m_skyline.size(); i++) {
+        int fitY = Fit(i, width, height);
+        if (fitY < 0)
+            continue;
+        int top = fitY + height;
+        if (top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth)) {
+            bestNode = i;
+            bestTop = top;
+            bestWidth = m_skyline[i].width;
+            y = fitY;
+        }
+    }
+    if (bestNode == m_skyline.size())
+        return false;
+    x = m_skyline[bestNode].x;
+
+    // 새 선분을 넣고 그 아래에 가려진 선분은 잘라낸다
+    m_skyline.insert(m_skyline.begin() + bestNode, { x, bestTop, width });
+    for (size_t i = bestNode + 1; i < m_skyline.size();) {
+        auto& previous = m_skyline[i - 1];
+        auto& node = m_skyline[i];
+        int shrink = previous.x + previous.width - node.x;
+        if (shrink <= 0)
+            break;
+        node.x += shrink;
+        node.width -= shrink;
+        if (node.width > 0)
+            break;
+        m_skyline.erase(m_skyline.begin() + i);
+    }
+    // 높이가 같은 이웃 선분은 합친다
+    for (size_t i = 0; i + 1 < m_skyline.size();) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        }
+        else {
+            i++;
+        }
+    }
+    m_usedArea += (uint64_t)width * height;
+    return true;
+}
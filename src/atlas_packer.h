@@ -0,0 +1,47 @@
+#ifndef __ATLAS_PACKER_H__
+#define __ATLAS_PACKER_H__
+
+#include "common.h"
+#include <vector>
+
+/*
+    skyline bottom-left 방식의 사각형 packer
+    배치된 사각형들의 윗면을 x축을 따라 이어진 선분(skyline)으로 관리하고
+    새 사각형은 윗면이 가장 낮아지는 위치에 놓는다
+    GL 의존성이 없으므로 worker thread나 benchmark에서도 사용할 수 있다
+*/
+CLASS_PTR(AtlasPacker)
+class AtlasPacker {
+public:
+    static AtlasPackerUPtr Create(int width, int height);
+
+    // 성공하면 x, y에 배치된 왼쪽 아래 위치
+    bool Insert(int width, int height, int& x, int& y);
+    void Clear();
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    uint64_t GetUsedArea() const { return m_usedArea; }
+    // 배치된 사각형 중 가장 높은 윗면
+    int GetUsedHeight() const;
+    // 배치된 사각형 넓이 / 전체 넓이 (0 ~ 1)
+    float GetOccupancy() const { return (float)m_usedArea / ((float)m_width * m_height); }
+
+private:
+    AtlasPacker() {}
+    bool Init(int width, int height);
+    // node부터 width만큼 덮었을 때 놓일 y. 들어가지 않으면 -1
+    int Fit(size_t node, int width, int height) const;
+
+    struct SkylineNode {
+        int x;
+        int y;
+        int width;
+    };
+    int m_width { 0 };
+    int m_height { 0 };
+    uint64_t m_usedArea { 0 };
+    std::vector<SkylineNode> m_skyline;
+};
+
+#endif // __ATLAS_PACKER_H__
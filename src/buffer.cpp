@@ -1,4 +1,5 @@
 #include "buffer.h"
+#include "render_state.h"
 
 BufferUPtr Buffer::CreateWithData(uint32_t bufferType, uint32_t usage, const void* data, size_t dataSize) {
     auto buffer = BufferUPtr(new Buffer());
@@ -9,12 +10,13 @@ BufferUPtr Buffer::CreateWithData(uint32_t bufferType, uint32_t usage, const voi
 
 Buffer::~Buffer() {
     if (m_buffer) {
+        RenderState::Get().ForgetBuffer(m_buffer);
         glDeleteBuffers(1, &m_buffer);
     }
 }
 
 void Buffer::Bind() const {
-    glBindBuffer(m_bufferType, m_buffer);
+    RenderState::Get().BindBuffer(m_bufferType, m_buffer);
 }
 
 bool Buffer::Init(uint32_t bufferType, uint32_t usage, const void* data, size_t dataSize) {
@@ -23,5 +25,66 @@ bool Buffer::Init(uint32_t bufferType, uint32_t usage, const void* data, size_t
     glGenBuffers(1, &m_buffer);
     Bind();
     glBufferData(m_bufferType, dataSize, data, usage);
+    m_size = dataSize;
+    return true;
+}
+
+void Buffer::SetData(const void* data, size_t dataSize) {
+    Bind();
+    if (dataSize != m_size) {
+        glBufferData(m_bufferType, dataSize, data, m_usage);
+        m_size = dataSize;
+        return;
+    }
+    // 크기가 같으면 기존 저장공간을 버리고(orphaning) 새로 채운다
+    // GPU가 이전 데이터를 사용하는 중이어도 기다리지 않음
+    glBufferData(m_bufferType, m_size, nullptr, m_usage);
+    if (data)
+        glBufferSubData(m_bufferType, 0, dataSize, data);
+}
+
+bool Buffer::Update(size_t offset, const void* data, size_t dataSize) {
+    // offset + dataSize는 overflow 될 수 있으므로 뺄셈으로 비교
+    if (offset > m_size || dataSize > m_size - offset) {
+        SPDLOG_ERROR("buffer update out of range: offset {}, size {}, buffer {}", offset, dataSize, m_size);
+        return false;
+    }
+    Bind();
+    glBufferSubData(m_bufferType, offset, dataSize, data);
+    return true;
+}
+
+void* Buffer::Map(size_t offset, size_t size, uint32_t access) const {
+    Bind();
+    return glMapBufferRange(m_bufferType, offset, size, access);
+}
+
+void Buffer::Unmap() const {
+    Bind();
+    glUnmapBuffer(m_bufferType);
+}
+
+UniformBufferUPtr UniformBuffer::Create(uint32_t binding, size_t dataSize) {
+    auto uniformBuffer = UniformBufferUPtr(new UniformBuffer());
+    if (!uniformBuffer->Init(binding, dataSize))
+        return nullptr;
+    return std::move(uniformBuffer);
+}
+
+void UniformBuffer::BindBase() const {
+    RenderState::Get().BindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_buffer->Get());
+}
+
+void UniformBuffer::Update(const void* data, size_t dataSize) {
+    m_buffer->SetData(data, dataSize);
+}
+
+bool UniformBuffer::Init(uint32_t binding, size_t dataSize) {
+    m_binding = binding;
+    m_buffer = Buffer::CreateWithData(
+        GL_UNIFORM_BUFFER, GL_DYNAMIC_DRAW, nullptr, dataSize);
+    if (!m_buffer)
+        return false;
+    BindBase();
     return true;
 }
\ No newline at end of file
@@ -9,7 +9,13 @@ public:
     static BufferUPtr CreateWithData(uint32_t bufferType, uint32_t usage, const void* data, size_t dataSize);
     ~Buffer();
     uint32_t Get() const { return m_buffer; }
+    size_t GetSize() const { return m_size; }
     void Bind() const;
+    void SetData(const void* data, size_t dataSize);
+    // 저장공간을 유지한 채 [offset, offset + dataSize) 구간만 갱신
+    bool Update(size_t offset, const void* data, size_t dataSize);
+    void* Map(size_t offset, size_t size, uint32_t access) const;
+    void Unmap() const;
 
 private:
     Buffer() {}
@@ -17,6 +23,29 @@ private:
     uint32_t m_buffer { 0 };
     uint32_t m_bufferType { 0 };
     uint32_t m_usage { 0 };
+    size_t m_size { 0 };
+};
+
+/*
+    uniform block(std140)에 대응하는 버퍼
+    binding point에 연결해 두고 여러 프로그램이 같은 데이터를 공유한다
+    갱신할 때마다 저장공간을 orphaning 하므로 GPU 사용 중에도 대기하지 않음
+*/
+CLASS_PTR(UniformBuffer)
+class UniformBuffer {
+public:
+    static UniformBufferUPtr Create(uint32_t binding, size_t dataSize);
+
+    uint32_t Get() const { return m_buffer->Get(); }
+    uint32_t GetBinding() const { return m_binding; }
+    void BindBase() const;
+    void Update(const void* data, size_t dataSize);
+
+private:
+    UniformBuffer() {}
+    bool Init(uint32_t binding, size_t dataSize);
+    BufferUPtr m_buffer;
+    uint32_t m_binding { 0 };
 };
 
 #endif // __BUFFER_H__
\ No newline at end of file
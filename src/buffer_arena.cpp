@@ -0,0 +1,201 @@
+#include "buffer_arena.h"
+#include "render_state.h"
+#include <algorithm>
+
+BufferArenaUPtr BufferArena::Create(uint32_t usage, size_t blockSize) {
+    auto arena = BufferArenaUPtr(new BufferArena());
+    arena->Init(usage, blockSize);
+    return std::move(arena);
+}
+
+void BufferArena::Init(uint32_t usage, size_t blockSize) {
+    m_usage = usage;
+    m_blockSize = blockSize;
+}
+
+bool BufferArena::AddBlock(size_t size) {
+    Block block;
+    block.buffer = Buffer::CreateWithData(GL_COPY_WRITE_BUFFER, m_usage, nullptr, size);
+    if (!block.buffer) {
+        SPDLOG_ERROR("failed to create buffer arena block: {} bytes", size);
+        return false;
+    }
+    block.size = size;
+    block.freeRanges.push_back({ 0, size });
+    m_blocks.push_back(std::move(block));
+    return true;
+}
+
+BufferArena::Handle BufferArena::Allocate(size_t size, size_t alignment) {
+    if (size == 0)
+        return kInvalidHandle;
+    alignment = std::max<size_t>(alignment, 1);
+
+    auto tryAllocate = [&](uint32_t blockIndex, Allocation& allocation) {
+        auto& ranges = m_blocks[blockIndex].freeRanges;
+        // first fit
+        for (size_t i = 0; i < ranges.size(); i++) {
+            auto range = ranges[i];
+            size_t alignedOffset = (range.offset + alignment - 1) / alignment * alignment;
+            size_t padding = alignedOffset - range.offset;
+            if (range.size < size + padding)
+                continue;
+            ranges.erase(ranges.begin() + i);
+            // 정렬로 생긴 앞쪽 여백과 남은 뒤쪽 구간은 다시 free list로
+            if (padding > 0)
+                InsertFreeRange(blockIndex, range.offset, padding);
+            size_t tail = range.size - size - padding;
+            if (tail > 0)
+                InsertFreeRange(blockIndex, alignedOffset + size, tail);
+            allocation = { blockIndex, alignedOffset, size, alignment };
+            return true;
+        }
+        return false;
+    };
+
+    Allocation allocation;
+    bool found = false;
+    for (uint32_t i = 0; i < (uint32_t)m_blocks.size() && !found; i++)
+        found = tryAllocate(i, allocation);
+    if (!found) {
+        if (!AddBlock(std::max(m_blockSize, size)))
+            return kInvalidHandle;
+        found = tryAllocate((uint32_t)m_blocks.size() - 1, allocation);
+        if (!found)
+            return kInvalidHandle;
+    }
+
+    Handle handle;
+    if (!m_freeHandles.empty()) {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_allocations[handle] = allocation;
+        m_allocationAlive[handle] = true;
+    }
+    else {
+        handle = (Handle)m_allocations.size();
+        m_allocations.push_back(allocation);
+        m_allocationAlive.push_back(true);
+    }
+    return handle;
+}
+
+void BufferArena::InsertFreeRange(uint32_t block, size_t offset, size_t size) {
+    auto& ranges = m_blocks[block].freeRanges;
+    auto it = std::lower_bound(ranges.begin(), ranges.end(), offset,
+        [](const FreeRange& range, size_t value) { return range.offset < value; });
+    it = ranges.insert(it, { offset, size });
+
+    // 뒤쪽 구간과 합치기
+    auto next = it + 1;
+    if (next != ranges.end() && it->offset + it->size == next->offset) {
+        it->size += next->size;
+        ranges.erase(next);
+    }
+    // 앞쪽 구간과 합치기
+    if (it != ranges.begin()) {
+        auto prev = it - 1;
+        if (prev->offset + prev->size == it->offset) {
+            prev->size += it->size;
+            ranges.erase(it);
+        }
+    }
+}
+
+void BufferArena::Free(Handle handle) {
+    if (handle >= m_allocations.size() || !m_allocationAlive[handle])
+        return;
+    auto& allocation = m_allocations[handle];
+    InsertFreeRange(allocation.block, allocation.offset, allocation.size);
+    m_allocationAlive[handle] = false;
+    m_freeHandles.push_back(handle);
+}
+
+bool BufferArena::Upload(Handle handle, const void* data, size_t size, size_t offset) {
+    if (handle >= m_allocations.size() || !m_allocationAlive[handle])
+        return false;
+    auto& allocation = m_allocations[handle];
+    if (offset + size > allocation.size) {
+        SPDLOG_ERROR("buffer arena upload out of range: {} > {}", offset + size, allocation.size);
+        return false;
+    }
+    return m_blocks[allocation.block].buffer->Update(allocation.offset + offset, data, size);
+}
+
+void BufferArena::Defragment() {
+    for (uint32_t blockIndex = 0; blockIndex < (uint32_t)m_blocks.size(); blockIndex++) {
+        auto& block = m_blocks[blockIndex];
+        bool compact = block.freeRanges.empty() ||
+            (block.freeRanges.size() == 1 &&
+             block.freeRanges[0].offset + block.freeRanges[0].size == block.size);
+        if (compact)
+            continue;
+
+        // 이 block에 속한 할당을 offset 순으로 정렬하고 새 위치 계산
+        std::vector<Handle> handles;
+        for (Handle h = 0; h < (Handle)m_allocations.size(); h++) {
+            if (m_allocationAlive[h] && m_allocations[h].block == blockIndex)
+                handles.push_back(h);
+        }
+        std::sort(handles.begin(), handles.end(), [this](Handle a, Handle b) {
+            return m_allocations[a].offset < m_allocations[b].offset;
+        });
+        std::vector<size_t> newOffsets;
+        size_t offset = 0;
+        for (auto h : handles) {
+            auto& allocation = m_allocations[h];
+            offset = (offset + allocation.alignment - 1) / allocation.alignment * allocation.alignment;
+            newOffsets.push_back(offset);
+            offset += allocation.size;
+        }
+
+        /*
+            같은 버퍼 내에서 겹치는 구간의 복사는 정의되지 않으므로
+            임시 버퍼로 모았다가 원래 버퍼로 되돌린다.
+            버퍼 오브젝트가 그대로이므로 VAO 설정을 다시 할 필요가 없음
+        */
+        if (offset > 0) {
+            auto temp = Buffer::CreateWithData(GL_COPY_WRITE_BUFFER, GL_STREAM_COPY, nullptr, offset);
+            if (!temp)
+                return;
+            RenderState::Get().BindBuffer(GL_COPY_READ_BUFFER, block.buffer->Get());
+            for (size_t i = 0; i < handles.size(); i++) {
+                auto& allocation = m_allocations[handles[i]];
+                glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                    allocation.offset, newOffsets[i], allocation.size);
+            }
+            RenderState::Get().BindBuffer(GL_COPY_READ_BUFFER, temp->Get());
+            RenderState::Get().BindBuffer(GL_COPY_WRITE_BUFFER, block.buffer->Get());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, offset);
+            RenderState::Get().BindBuffer(GL_COPY_READ_BUFFER, 0);
+            RenderState::Get().BindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+
+        for (size_t i = 0; i < handles.size(); i++)
+            m_allocations[handles[i]].offset = newOffsets[i];
+        block.freeRanges.clear();
+        if (offset < block.size)
+            block.freeRanges.push_back({ offset, block.size - offset });
+    }
+}
+
+BufferArena::Stats BufferArena::GetStats() const {
+    Stats stats;
+    stats.blockCount = m_blocks.size();
+    for (auto& block : m_blocks) {
+        stats.capacity += block.size;
+        stats.freeRangeCount += block.freeRanges.size();
+        for (auto& range : block.freeRanges) {
+            stats.largestFreeRange = std::max(stats.largestFreeRange, range.size);
+            if (range.offset + range.size != block.size)
+                stats.holeSize += range.size;
+        }
+    }
+    for (size_t i = 0; i < m_allocations.size(); i++) {
+        if (!m_allocationAlive[i])
+            continue;
+        stats.usedSize += m_allocations[i].size;
+        stats.allocationCount++;
+    }
+    return stats;
+}
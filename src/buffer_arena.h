@@ -0,0 +1,78 @@
+#ifndef __BUFFER_ARENA_H__
+#define __BUFFER_ARENA_H__
+
+#include "buffer.h"
+
+/*
+    몇 개의 큰 GL 버퍼(block)를 만들어 두고 (offset, size) 단위로 나누어 주는 할당기
+    작은 mesh 수천 개가 각자 버퍼 오브젝트를 만들지 않고 같은 버퍼를 공유하므로
+    하나의 VAO에서 glDrawElementsBaseVertex 로 그릴 수 있다.
+    block마다 offset 순으로 정렬된 free list를 가지며 해제 시 이웃 구간과 합친다.
+    버퍼 오브젝트는 target과 무관하므로 block 생성 / 업로드는 GL_COPY_WRITE_BUFFER로 한다
+    (GL_ELEMENT_ARRAY_BUFFER에 바인딩하면 현재 바인딩된 VAO의 index buffer가 바뀐다)
+    그리는 쪽에서 block 버퍼를 용도에 맞는 target / VAO에 직접 연결한다
+*/
+CLASS_PTR(BufferArena)
+class BufferArena {
+public:
+    // Defragment 후에도 유효한 할당 식별자
+    using Handle = uint32_t;
+    static constexpr Handle kInvalidHandle = 0xffffffff;
+
+    struct Allocation {
+        uint32_t block { 0 };
+        size_t offset { 0 };
+        size_t size { 0 };
+        size_t alignment { 1 };
+    };
+
+    struct Stats {
+        size_t blockCount { 0 };
+        size_t capacity { 0 };
+        size_t usedSize { 0 };
+        size_t allocationCount { 0 };
+        size_t freeRangeCount { 0 };
+        size_t largestFreeRange { 0 };
+        size_t holeSize { 0 }; // block 끝에 붙지 않은 free 구간의 합 (Defragment로 회수 가능한 크기)
+    };
+
+    static BufferArenaUPtr Create(uint32_t usage, size_t blockSize = 16 * 1024 * 1024);
+
+    // alignment는 정점 stride의 배수로 주면 offset / stride 를 base vertex로 사용 가능. 0은 1로 취급
+    Handle Allocate(size_t size, size_t alignment = 16);
+    void Free(Handle handle);
+    bool Upload(Handle handle, const void* data, size_t size, size_t offset = 0);
+
+    const Allocation& GetAllocation(Handle handle) const { return m_allocations[handle]; }
+    const Buffer* GetBuffer(uint32_t block) const { return m_blocks[block].buffer.get(); }
+    size_t GetBlockCount() const { return m_blocks.size(); }
+
+    // 살아있는 할당을 block 앞쪽으로 모아 free 구간을 하나로 합친다 (GPU 복사)
+    void Defragment();
+    Stats GetStats() const;
+
+private:
+    BufferArena() {}
+    void Init(uint32_t usage, size_t blockSize);
+    bool AddBlock(size_t size);
+    void InsertFreeRange(uint32_t block, size_t offset, size_t size);
+
+    struct FreeRange {
+        size_t offset;
+        size_t size;
+    };
+    struct Block {
+        BufferUPtr buffer;
+        size_t size { 0 };
+        std::vector<FreeRange> freeRanges;
+    };
+
+    uint32_t m_usage { 0 };
+    size_t m_blockSize { 0 };
+    std::vector<Block> m_blocks;
+    std::vector<Allocation> m_allocations;
+    std::vector<bool> m_allocationAlive;
+    std::vector<Handle> m_freeHandles;
+};
+
+#endif // __BUFFER_ARENA_H__
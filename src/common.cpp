@@ -1,14 +1,30 @@
 #include "common.h"
-#include <fstream>
-#include <sstream>
+#include "mapped_file.h"
+#include <filesystem>
 
 std::optional<std::string> LoadTextFile(const std::string& filename) {
-    std::ifstream fin(filename);
-    if (!fin.is_open()) {
-        SPDLOG_ERROR("failed to open file: {}", filename);
+    // 파일을 매핑해 한번만 복사한다. 복사 없이 읽으려면 MappedFile을 직접 사용
+    auto file = MappedFile::Open(filename);
+    if (!file)
         return {};
-    }
-    std::stringstream text;
-    text << fin.rdbuf();
-    return text.str();
-}
\ No newline at end of file
+    return std::string(file->GetText());
+}
+bool GetFileStamp(const std::string& filename, uint64_t& size, int64_t& time) {
+    std::error_code ec;
+    size = (uint64_t)std::filesystem::file_size(filename, ec);
+    if (ec)
+        return false;
+    auto writeTime = std::filesystem::last_write_time(filename, ec);
+    if (ec)
+        return false;
+    time = (int64_t)writeTime.time_since_epoch().count();
+    return true;
+}
+
+std::string NormalizePath(const std::string& filename) {
+    std::error_code ec;
+    auto path = std::filesystem::absolute(filename, ec);
+    if (ec)
+        path = filename;
+    return path.lexically_normal().generic_string();
+}
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <optional>
+#include <string_view>
 #include <spdlog/spdlog.h>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -22,4 +23,20 @@ std::optional<std::string> LoadTextFile(const std::string& filename);
 // <-> std::string* LoadTextFile(const std::string& filename);
 // 동적할당된 포인터 메모리 해제 누락 방지를 위해 포인터를 안쓰는게 좋다.
 
+// 파일의 크기와 수정 시간. 디스크 캐시의 유효성 검사에 사용
+bool GetFileStamp(const std::string& filename, uint64_t& size, int64_t& time);
+
+// 절대 경로로 바꾸고 "./", "../"를 정리. 같은 파일을 가리키는 경로를 비교할 때 사용
+std::string NormalizePath(const std::string& filename);
+
+// 64bit FNV-1a 문자열 해시. constexpr 이므로 컴파일 타임에 계산 가능
+constexpr uint64_t HashString(std::string_view str, uint64_t seed = 14695981039346656037ull) {
+    uint64_t hash = seed;
+    for (char c : str) {
+        hash ^= (uint8_t)c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
 #endif // __COMMON_H__
\ No newline at end of file
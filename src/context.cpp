@@ -1,115 +1,155 @@
 #include "context.h"
 #include "image.h"
+#include "image_ops.h"
+#include "profiler.h"
+#include "render_state.h"
+#include <random>
 
-ContextUPtr Context::Create() {
+ContextUPtr Context::Create(size_t objectCount, size_t materialCount, MaterialPacking packing) {
     auto context = ContextUPtr(new Context());
-    if (!context->Init())
+    if (!context->Init(objectCount, materialCount, packing))
         return nullptr;
     return std::move(context);
 }
 
-bool Context::Init() {
-    float vertices[] = {
-        -0.5f, -0.5f, -0.5f, 0.0f, 0.0f,
-        0.5f, -0.5f, -0.5f, 1.0f, 0.0f,
-        0.5f,  0.5f, -0.5f, 1.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f, 0.0f, 1.0f,
-
-        -0.5f, -0.5f,  0.5f, 0.0f, 0.0f,
-        0.5f, -0.5f,  0.5f, 1.0f, 0.0f,
-        0.5f,  0.5f,  0.5f, 1.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f, 0.0f, 1.0f,
-
-        -0.5f,  0.5f,  0.5f, 1.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f, 1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f, 0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f, 0.0f, 0.0f,
-
-        0.5f,  0.5f,  0.5f, 1.0f, 0.0f,
-        0.5f,  0.5f, -0.5f, 1.0f, 1.0f,
-        0.5f, -0.5f, -0.5f, 0.0f, 1.0f,
-        0.5f, -0.5f,  0.5f, 0.0f, 0.0f,
-
-        -0.5f, -0.5f, -0.5f, 0.0f, 1.0f,
-        0.5f, -0.5f, -0.5f, 1.0f, 1.0f,
-        0.5f, -0.5f,  0.5f, 1.0f, 0.0f,
-        -0.5f, -0.5f,  0.5f, 0.0f, 0.0f,
-
-        -0.5f,  0.5f, -0.5f, 0.0f, 1.0f,
-        0.5f,  0.5f, -0.5f, 1.0f, 1.0f,
-        0.5f,  0.5f,  0.5f, 1.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f, 0.0f, 0.0f,
-    };
+bool Context::Init(size_t objectCount, size_t materialCount, MaterialPacking packing) {
+    // 메쉬는 공유 arena에 올리고 storage의 VAO 하나로 그린다
+    // storage가 만드는 모든 VAO에서 InstanceData attribute(location 3 ~ 8)는 인스턴스마다 갱신
+    m_meshStorage = MeshStorage::Create();
+    m_meshStorage->SetInstanceAttribs(DrawCommand::kInstanceAttribLocation, DrawCommand::kInstanceLayerLocation);
+    m_mesh = Mesh::Load("./model/cube.obj", m_meshStorage);
+    if (!m_mesh)
+        return false;
 
     /*
-        정점의 인덱스를 저장할 수 있는 버퍼
-        인덱스 버퍼라고도 부름
-        정점 정보와 별개로 정점의 인덱스로만 구성된 삼각형 정보를 전달 가능
-        indexed drawing
+        인스턴스별 model 행렬과 material 영역(InstanceData)을 담을 스트리밍 버퍼
+        mat4 attribute는 vec4 4개(location 3~6)로 나누어 설정하고, atlas 영역은 location 7, 8
+        divisor는 mesh storage에서 VAO를 만들 때 1로 지정되어 인스턴스마다 다음 값을 읽는다
+        프레임 / LOD마다 읽는 위치가 바뀌므로 attribute offset은 draw 직전에 render queue에서 설정
     */
-    uint32_t indices[] = {
-        0,  2,  1,  2,  0,  3,
-        4,  5,  6,  6,  7,  4,
-        8,  9, 10, 10, 11,  8,
-        12, 14, 13, 14, 12, 15,
-        16, 17, 18, 18, 19, 16,
-        20, 22, 21, 22, 20, 23,
-    };
+    m_instanceStream = StreamBuffer::Create(
+        GL_ARRAY_BUFFER, sizeof(InstanceData) * std::max<size_t>(objectCount, 1024));
+    if (!m_instanceStream)
+        return false;
 
+    // 같은 파일에서 #define만 다른 permutation으로 일반 / instanced program을 만든다
+    // link된 program binary는 디스크에 캐시하여 다음 실행부터는 소스 컴파일을 건너뛴다
+    auto programStart = glfwGetTime();
+    m_shaderLibrary = ShaderLibrary::Create();
+    if (!m_shaderLibrary)
+        return false;
     /*
-        ※ 순서 주의
-        vertex attribute을 설정하기 전에 VBO가 바인딩 되어있을 것
+        material의 atlas 영역을 읽는 permutation. texture array material은 sampler 형식이 달라
+        program을 따로 만든다 (ProgramSet 1번)
+        모든 program을 먼저 요청해 두고 driver가 병렬로 컴파일하는 동안 기다린다
+        양자화된 메쉬는 normal을 octahedral encoding으로 저장하므로 vertex shader에서 복원
     */
-    // 1. VAO binding
-    m_vertexLayout = VertexLayout::Create(); 
-
-    // 2. VBO binding
-    m_vertexBuffer = Buffer::CreateWithData( 
-        GL_ARRAY_BUFFER, GL_STATIC_DRAW, vertices, sizeof(float) * 120);
-
-    // 3. vertex attribute setting
-	m_vertexLayout->SetAttrib(0, 3, GL_FLOAT, GL_FALSE, sizeof(float) * 5, 0); 
-    m_vertexLayout->SetAttrib(2, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 5, sizeof(float) * 3);
+    ShaderDefines defines = { { "ATLAS", "1" } };
+    if (m_mesh->GetVertexFormat() == MeshVertexFormat::Quantized)
+        defines.push_back({ "PACKED_NORMAL", "1" });
+    size_t programSetCount = packing == MaterialPacking::Array && materialCount > 1 ? 2 : 1;
+    std::vector<ShaderDefines> permutations;
+    for (size_t i = 0; i < programSetCount; i++) {
+        ShaderDefines setDefines = defines;
+        if (i == 1)
+            setDefines.push_back({ "TEXTURE_ARRAY", "1" });
+        ShaderDefines instanceDefines = setDefines;
+        instanceDefines.push_back({ "INSTANCED", "1" });
+        permutations.push_back(setDefines);
+        permutations.push_back(instanceDefines);
+    }
+    for (auto& permutation : permutations)
+        m_shaderLibrary->RequestProgram("./shader/texture.vs", "./shader/texture.fs", permutation);
+    m_programSets.resize(programSetCount);
+    for (size_t i = 0; i < programSetCount; i++) {
+        auto& programSet = m_programSets[i];
+        programSet.program = m_shaderLibrary->GetProgram("./shader/texture.vs", "./shader/texture.fs",
+            permutations[i * 2]);
+        programSet.instanceProgram = m_shaderLibrary->GetProgram("./shader/texture.vs", "./shader/texture.fs",
+            permutations[i * 2 + 1]);
+        if (!programSet.program || !programSet.instanceProgram)
+            return false;
+        SPDLOG_INFO("program id: {}, instance program id: {}",
+            programSet.program->Get(), programSet.instanceProgram->Get());
+    }
+    auto programCache = m_shaderLibrary->GetProgramCache();
+    SPDLOG_INFO("programs ready: {:.2f} ms ({} shaders, binary cache hit: {}, miss: {})",
+        (glfwGetTime() - programStart) * 1000.0, m_shaderLibrary->GetShaderCount(),
+        programCache ? programCache->GetHitCount() : 0,
+        programCache ? programCache->GetMissCount() : 0);
+
+    // 두 프로그램이 같은 binding point의 카메라 데이터를 공유
+    m_cameraBuffer = UniformBuffer::Create(kCameraBinding, sizeof(CameraBlock));
+    if (!m_cameraBuffer)
+        return false;
 
-    m_indexBuffer = Buffer::CreateWithData(
-        GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW, indices, sizeof(uint32_t) * 36);
+    m_renderQueue = RenderQueue::Create(objectCount);
 
-    ShaderPtr vertShader = Shader::CreateFromFile("./shader/texture.vs", GL_VERTEX_SHADER);
-    ShaderPtr fragShader = Shader::CreateFromFile("./shader/texture.fs", GL_FRAGMENT_SHADER);
-    if (!vertShader || !fragShader)
-        return false;
-    SPDLOG_INFO("vertex shader id: {}", vertShader->Get());
-    SPDLOG_INFO("fragment shader id: {}", fragShader->Get());
+    std::vector<glm::vec3> cubePositions = {
+        glm::vec3( 0.0f, 0.0f, 0.0f),
+        glm::vec3( 2.0f, 5.0f, -15.0f),
+        glm::vec3(-1.5f, -2.2f, -2.5f),
+        glm::vec3(-3.8f, -2.0f, -12.3f),
+        glm::vec3( 2.4f, -0.4f, -3.5f),
+        glm::vec3(-1.7f, 3.0f, -7.5f),
+        glm::vec3( 1.3f, -2.0f, -2.5f),
+        glm::vec3( 1.5f, 2.0f, -2.5f),
+        glm::vec3( 1.5f, 0.2f, -1.5f),
+        glm::vec3(-1.3f, 1.0f, -1.5f),
+    };
+    cubePositions.resize(std::min(cubePositions.size(), objectCount));
+    // 나머지는 시야(45도) 안쪽에 무작위로 흩어 놓는다
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> distance(3.0f, kFarPlane - 5.0f);
+    while (cubePositions.size() < objectCount) {
+        float z = distance(random);
+        cubePositions.push_back(glm::vec3(unit(random) * z * 0.7f, unit(random) * z * 0.4f, -z));
+    }
 
-    m_program = Program::Create({fragShader, vertShader});
-    if (!m_program)
-        return false;
-    SPDLOG_INFO("program id: {}", m_program->Get());
+    m_jobSystem = JobSystem::Create();
+    m_scene = Scene::Create(m_jobSystem.get(), cubePositions.size());
+    // 큐브는 제자리에서 회전만 하므로 회전과 무관한 bounding volume을 한번만 등록
+    // (한 변이 1인 정육면체의 bounding sphere 반지름 = sqrt(3) / 2)
+    m_culling = CullingSystem::Create(cubePositions.size());
+    m_cubeRadius = glm::sqrt(3.0f) * 0.5f;
+    for (size_t i = 0; i < cubePositions.size(); i++) {
+        // 큐브는 모두 root 노드이므로 node index와 culling object index가 같다
+        uint32_t node = m_scene->AddNode(Scene::kInvalidNode, cubePositions[i]);
+        m_scene->SetSpin(node, glm::vec3(1.0f, 0.5f, 0.0f), 120.0f, 20.0f * (float)i);
+        m_culling->Add(cubePositions[i], m_cubeRadius);
+    }
+    m_lodSelector = LodSelector::Create();
 
     glClearColor(0.1f, 0.2f, 0.3f, 0.0f);
 
-    auto image = Image::Load("./image/container.jpg");
-    if (!image) 
+    // 이미지 디코딩은 백그라운드에서 진행하고, 완료 전까지는 체크 무늬 텍스처 사용
+    m_textureLoader = TextureLoader::Create();
+    if (!m_textureLoader)
         return false;
-    SPDLOG_INFO("image: {}x{}, {} channels",image->GetWidth(), image->GetHeight(), image->GetChannelCount());
-
-    m_texture = Texture::CreateFromImage(image.get());
+    m_texture = m_textureLoader->Load("./image/container.jpg");
 
     // 텍스처 최대 32개 까지 동시 사용 가능함
-    auto image2 = Image::Load("./image/awesomeface.png");
-    m_texture2 = Texture::CreateFromImage(image2.get());
+    m_texture2 = m_textureLoader->Load("./image/awesomeface.png");
 
     // 텍스처 슬롯0에 m_texture1 텍스처 오브젝트 바인딩
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_texture->Get());
+    m_texture->Bind(0);
     // 텍스처 슬롯1에 m_texture2 텍스처 오브젝트 바인딩
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, m_texture2->Get());
+    m_texture2->Bind(1);
 
-    m_program->Use();
-    // sampler2D uniform에 텍스처 슬롯 인덱스를 입력
-    m_program->SetUniform("tex", 0);
-    m_program->SetUniform("tex2", 1);
+    if (!InitMaterials(materialCount, packing))
+        return false;
+    m_objectMaterials.resize(cubePositions.size());
+    for (size_t i = 0; i < cubePositions.size(); i++)
+        m_objectMaterials[i] = (uint32_t)(i % m_materials.size());
+
+    if (!SetupPrograms())
+        return false;
+
+    // shader / 텍스처 파일이 바뀌면 재시작 없이 해당 객체만 다시 만든다
+    // 감시를 시작할 수 없으면 hot reload 없이 동작
+    m_fileWatcher = FileWatcher::Create();
+    WatchSourceFiles();
 
     // 위치 (1, 0, 0)의 점. 동차좌표계 사용
     glm::vec4 vec(1.0f, 0.0f, 0.0f, 1.0f);
@@ -124,70 +164,249 @@ bool Context::Init() {
     // (3, 0, 0) => (0, 3, 0) => (1, 4, 0)
     SPDLOG_INFO("transformed vec: [{}, {}, {}]", vec.x, vec.y, vec.z);
 
-    // 0.5배 축소후 z축으로 90도 회전하는 행렬
-    // auto transform = glm::rotate(
-    //     glm::scale(glm::mat4(1.0f), glm::vec3(0.5f)),
-    //     glm::radians(90.0f), glm::vec3(0.0f, 0.0f, 1.0f)
-    //     );
-
-    // x축으로 -55도 회전
-    auto model = glm::rotate(glm::mat4(1.0f), glm::radians(-55.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-    // 카메라는 원점으로부터 z축 방향으로 -3만큼 떨어짐
-    auto view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -3.0f));
-    // 종횡비 4:3, 세로화각 45도의 원근 투영
-    auto projection = glm::perspective(glm::radians(45.0f), (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT, 0.01f, 10.0f);
-    auto transform = projection * view * model;
-    m_program->SetUniform("transform", transform);
+    return true;
+}
+
+bool Context::InitMaterials(size_t materialCount, MaterialPacking packing) {
+    // 0번 material은 백그라운드로 로딩하는 awesomeface 이미지라서 atlas에 넣지 않고 혼자 한 group
+    m_materialGroups.push_back({ m_texture2, 0 });
+    m_materials.push_back({ 0, AtlasRegion() });
+
+    // 나머지 material은 색과 격자 크기가 다른 체크 무늬로 만든다
+    std::mt19937 random(5678);
+    std::vector<ImageUPtr> images;
+    for (size_t i = 1; i < materialCount; i++) {
+        auto image = Image::Create(64, 64);
+        if (!image)
+            return false;
+        ImageOps::FillChecker(image.get(), 2 + (int)(i % 7), 2 + (int)(i / 7 % 7));
+        glm::vec3 tint = glm::vec3(random() % 256, random() % 256, random() % 256) / 255.0f;
+        uint8_t* pixel = image->GetData();
+        for (int j = 0; j < image->GetWidth() * image->GetHeight(); j++, pixel += 4) {
+            for (int c = 0; c < 3; c++)
+                pixel[c] = (uint8_t)(pixel[c] * tint[c]);
+        }
+        images.push_back(std::move(image));
+    }
+    if (images.empty())
+        return true;
+
+    if (packing == MaterialPacking::None) {
+        for (auto& image : images) {
+            m_materials.push_back({ (uint32_t)m_materialGroups.size(), AtlasRegion() });
+            m_materialGroups.push_back({ Texture::CreateFromImage(image.get()), 0 });
+        }
+        return true;
+    }
+
+    // 텍스처 하나에 모두 모으면 material 수와 관계없이 LOD마다 batch 하나로 그릴 수 있다
+    std::vector<const Image*> atlasImages;
+    for (auto& image : images)
+        atlasImages.push_back(image.get());
+    auto atlas = packing == MaterialPacking::Array ?
+        TextureAtlas::CreateArray(atlasImages) : TextureAtlas::CreateAtlas(atlasImages);
+    if (!atlas)
+        return false;
+    uint32_t group = (uint32_t)m_materialGroups.size();
+    m_materialGroups.push_back({ atlas->GetTexture(), packing == MaterialPacking::Array ? 1u : 0u });
+    for (size_t i = 0; i < atlas->GetRegionCount(); i++)
+        m_materials.push_back({ group, atlas->GetRegion(i) });
+    return true;
+}
+
+bool Context::SetupPrograms() {
+    for (auto& programSet : m_programSets) {
+        // 모든 프로그램이 같은 binding point의 카메라 데이터를 공유
+        for (auto program : { programSet.instanceProgram.get(), programSet.program.get() }) {
+            if (!program->SetUniformBlockBinding("Camera", kCameraBinding))
+                return false;
+            program->Use();
+            // sampler uniform에 텍스처 슬롯 인덱스를 입력
+            program->SetUniform("tex", 0);
+            program->SetUniform("tex2", 1);
+            // 메쉬가 하나뿐이므로 position 복원 값은 한번만 설정
+            program->SetUniform("positionScale", m_mesh->GetPositionScale());
+            program->SetUniform("positionOffset", m_mesh->GetPositionOffset());
+        }
 
+        // 매 draw마다 사용하는 uniform은 location을 미리 조회해 둔다
+        programSet.modelUniform = programSet.program->GetUniformHandle("model");
+        programSet.uvRectUniform = programSet.program->GetUniformHandle("uvRect");
+        programSet.layerUniform = programSet.program->GetUniformHandle("layer");
+    }
     return true;
 }
 
+void Context::WatchSourceFiles() {
+    if (!m_fileWatcher)
+        return;
+    for (auto& file : m_shaderLibrary->GetSourceFiles())
+        m_fileWatcher->Watch(file);
+    for (auto& file : m_textureLoader->GetSourceFiles())
+        m_fileWatcher->Watch(file);
+}
+
+void Context::ReloadChangedFiles() {
+    PROFILE_SCOPE("Context::ReloadChangedFiles");
+    auto changedFiles = m_fileWatcher->TakeChanges();
+    for (auto& file : changedFiles)
+        SPDLOG_INFO("file changed: {}", file);
+    // program이 교체되면 uniform 값이 초기화되므로 다시 설정
+    if (m_shaderLibrary->Reload(changedFiles) > 0)
+        SetupPrograms();
+    m_textureLoader->Reload(changedFiles);
+    // 새로 #include된 파일도 감시
+    WatchSourceFiles();
+}
+
 void Context::Render() {
-    std::vector<glm::vec3> cubePositions = {
-        glm::vec3( 0.0f, 0.0f, 0.0f),
-        glm::vec3( 2.0f, 5.0f, -15.0f),
-        glm::vec3(-1.5f, -2.2f, -2.5f),
-        glm::vec3(-3.8f, -2.0f, -12.3f),
-        glm::vec3( 2.4f, -0.4f, -3.5f),
-        glm::vec3(-1.7f, 3.0f, -7.5f),
-        glm::vec3( 1.3f, -2.0f, -2.5f),
-        glm::vec3( 1.5f, 2.0f, -2.5f),
-        glm::vec3( 1.5f, 0.2f, -1.5f),
-        glm::vec3(-1.3f, 1.0f, -1.5f),
-    };
+    PROFILE_SCOPE("Context::Render");
+    PROFILE_GPU_SCOPE("Context::Render");
+
+    // 변경된 파일이 없으면 atomic flag 확인 한번으로 끝난다
+    if (m_fileWatcher && m_fileWatcher->HasChanges())
+        ReloadChangedFiles();
+
+    // 디코딩이 끝난 텍스처가 있으면 업로드
+    if (m_textureLoader->GetPendingCount() > 0)
+        m_textureLoader->Update();
+    // 백그라운드로 요청해 둔 program 중 link가 끝난 것 마무리
+    if (m_shaderLibrary->GetPendingCount() > 0)
+        m_shaderLibrary->Update();
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glEnable(GL_DEPTH_TEST);
+    // 상태가 이미 같으면 RenderState에서 GL 호출을 생략하므로 매 프레임 설정해도 된다
+    RenderState::Get().Enable(GL_DEPTH_TEST);
+    m_mesh->GetVertexLayout()->Bind();
+    m_texture->Bind(0);
+    m_texture2->Bind(1);
 
     // (0, 0, -1) 방향을 x축, y축에 따라 회전
     m_cameraFront = glm::rotate(glm::mat4(1.0f), glm::radians(m_cameraYaw), glm::vec3(0.0f, 1.0f, 0.0f)) * 
     glm::rotate(glm::mat4(1.0f), glm::radians(m_cameraPitch), glm::vec3(1.0f, 0.0f, 0.0f)) *
     glm::vec4(0.0f, 0.0f, -1.0f, 0.0f); // 회전을 위해 w = 0 <= 평행이동 X
 
-    auto projection = glm::perspective(glm::radians(45.0f), (float)m_width / (float)m_height, 0.01f, 50.0f);
-
-    auto view = glm::lookAt(
+    // view / projection은 프레임당 한번만 계산해서 uniform buffer로 공유
+    CameraBlock camera;
+    camera.projection = glm::perspective(glm::radians(45.0f), (float)m_width / (float)m_height, kNearPlane, kFarPlane);
+    camera.view = glm::lookAt(
       m_cameraPos,
       m_cameraPos + m_cameraFront,
       m_cameraUp);
+    camera.viewProjection = camera.projection * camera.view;
+    m_cameraBuffer->Update(&camera, sizeof(CameraBlock));
+
+    // transform은 job system에서 병렬로 계산하고, 화면 밖의 큐브는 그리기에서 제외
+    float time = (float)(m_fixedTime ? *m_fixedTime : glfwGetTime());
+    m_scene->Update(time);
+    m_culling->Cull(Frustum::FromMatrix(camera.viewProjection), m_visibleObjects);
+
+    // 화면 크기로 물체별 LOD를 고르고, 같은 (LOD, material group)끼리 연속되도록 counting sort
+    // atlas에 모은 material은 group이 같으므로 material 수와 관계없이 한 batch가 된다
+    uint32_t lodCount = m_mesh->GetLodCount();
+    uint32_t groupCount = (uint32_t)m_materialGroups.size();
+    uint32_t batchCount = lodCount * groupCount;
+    auto& worldTransforms = m_scene->GetTransforms();
+    m_visibleBatches.resize(m_visibleObjects.size());
+    m_batchStarts.assign(batchCount + 1, 0);
+    for (size_t i = 0; i < m_visibleObjects.size(); i++) {
+        uint32_t object = m_visibleObjects[i];
+        float screenSize = LodSelector::ComputeScreenSize(glm::vec3(worldTransforms[object][3]),
+            m_cubeRadius, camera.view, camera.projection);
+        uint32_t lod = m_lodSelector->Select(object, screenSize, lodCount);
+        m_visibleBatches[i] = lod * groupCount + m_materials[m_objectMaterials[object]].group;
+        m_batchStarts[m_visibleBatches[i] + 1]++;
+    }
+    // m_batchStarts[batch] ~ m_batchStarts[batch + 1]: 해당 batch 물체들의 구간
+    for (uint32_t batch = 0; batch < batchCount; batch++)
+        m_batchStarts[batch + 1] += m_batchStarts[batch];
+    m_batchCursors.assign(m_batchStarts.begin(), m_batchStarts.end() - 1);
+    m_batchObjects.resize(m_visibleObjects.size());
+    for (size_t i = 0; i < m_visibleObjects.size(); i++)
+        m_batchObjects[m_batchCursors[m_visibleBatches[i]]++] = m_visibleObjects[i];
+
+    // batch 순서로 world 행렬과 material 영역을 모은다
+    m_instances.resize(m_batchObjects.size());
+    m_jobSystem->ParallelFor(m_batchObjects.size(), kInstanceGrainSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            uint32_t object = m_batchObjects[i];
+            auto& region = m_materials[m_objectMaterials[object]].region;
+            auto& instance = m_instances[i];
+            instance.model = worldTransforms[object];
+            instance.uvRect = glm::vec4(region.uvOffset.x, region.uvOffset.y, region.uvScale.x, region.uvScale.y);
+            instance.layer = (float)region.layer;
+        }
+    });
 
-    for (size_t i = 0; i < cubePositions.size(); i++) {
-        auto& pos = cubePositions[i];
-        auto model = glm::translate(glm::mat4(1.0f), pos);
-        model = glm::rotate(model,
-            glm::radians((float)glfwGetTime() * 120.0f + 20.0f * (float)i),
-            glm::vec3(1.0f, 0.5f, 0.0f));
-        auto transform = projection * view * model;
-        m_program->SetUniform("transform", transform);
-        /*
-            현재 바인딩된 VAO, VBO, EBO를 바탕으로 그리기
-            primitive: 그려낼 기본 primitive 타입
-            count: 그리고자 하는 EBO 내 index의 개수
-            type: index의 데이터형
-            pointer/offset: 그리고자 하는 EBO의 첫 데이터로부터의 오프셋
-        */
-        glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
+    /*
+        그리기 명령을 바로 실행하지 않고 render queue에 모은 뒤
+        sort key 순서로 정렬하여 실행한다
+        indexCount: 그리고자 하는 EBO 내 index의 개수
+        indexOffset: 그리고자 하는 EBO의 첫 데이터로부터의 오프셋
+        같은 텍스처의 명령이 이어지도록 정렬되어 텍스처 바인딩 변경이 material group 수 정도로 줄어든다
+    */
+    DrawCommand command = {};
+    command.vertexLayout = m_mesh->GetVertexLayout();
+    command.textures[0] = m_texture->Get();
+    command.indexType = m_mesh->GetIndexType();
+    command.baseVertex = m_mesh->GetBaseVertex();
+
+    // 보이는 큐브가 없으면 instance buffer에 쓸 것도 없음
+    bool instanced = m_instancing && !m_instances.empty();
+    bool streamed = instanced;
+    size_t offset = 0;
+    if (instanced) {
+        // 이번 프레임에 쓸 크기를 미리 알려주어 offset을 받기 전에 구간을 늘린다
+        size_t instanceSize = sizeof(InstanceData) * m_instances.size();
+        m_instanceStream->BeginFrame(instanceSize);
+        offset = m_instanceStream->Write(m_instances.data(), instanceSize, sizeof(InstanceData));
+        // 쓰지 못했으면 이번 프레임은 물체별 draw로 그린다
+        instanced = offset != StreamBuffer::kInvalidOffset;
     }
+    if (instanced)
+        command.instanceBuffer = m_instanceStream->GetBuffer()->Get();
+    for (uint32_t batch = 0; batch < batchCount; batch++) {
+        uint32_t begin = m_batchStarts[batch];
+        uint32_t end = m_batchStarts[batch + 1];
+        if (begin == end)
+            continue;
+        auto& range = m_mesh->GetLod(batch / groupCount);
+        auto& group = m_materialGroups[batch % groupCount];
+        auto& programSet = m_programSets[group.programSet];
+        command.indexOffset = m_mesh->GetIndexOffset() + range.indexOffset * m_mesh->GetIndexSize();
+        command.indexCount = range.indexCount;
+        command.textures[1] = group.texture->Get();
+        command.textureTargets[1] = group.texture->GetTarget();
+        uint32_t materialId = RenderQueue::MakeMaterialId(command.textures, DrawCommand::kMaxTextureCount);
+        if (instanced) {
+            // batch의 model 행렬 / material 영역을 한번에 올리고 draw call 한번으로 그리기
+            command.program = programSet.instanceProgram.get();
+            command.key = RenderQueue::MakeKey(RenderPass::Opaque,
+                command.program->Get(), materialId, 0.0f);
+            command.instanceOffset = offset + sizeof(InstanceData) * begin;
+            command.instanceCount = end - begin;
+            m_renderQueue->Submit(command);
+            continue;
+        }
+        command.program = programSet.program.get();
+        command.modelUniform = programSet.modelUniform;
+        command.uvRectUniform = programSet.uvRectUniform;
+        command.layerUniform = programSet.layerUniform;
+        for (uint32_t i = begin; i < end; i++) {
+            // 카메라 공간에서의 거리를 far plane 기준으로 정규화
+            float depth = -(camera.view * m_instances[i].model[3]).z / kFarPlane;
+            command.instanceIndex = m_renderQueue->AddInstance(m_instances[i]);
+            command.key = RenderQueue::MakeKey(RenderPass::Opaque,
+                command.program->Get(), materialId, depth);
+            m_renderQueue->Submit(command);
+        }
+    }
+
+    m_renderQueue->Sort();
+    m_renderQueue->Execute();
+    m_renderQueue->Clear();
+    if (streamed)
+        m_instanceStream->EndFrame();
 }
 
 void Context::ProcessInput(GLFWwindow* window) {
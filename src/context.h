@@ -4,32 +4,130 @@
 #include "common.h"
 #include "shader.h"
 #include "program.h"
+#include "shader_library.h"
+#include "file_watcher.h"
 #include "buffer.h"
+#include "stream_buffer.h"
 #include "vertex_layout.h"
+#include "mesh.h"
 #include "texture.h"
+#include "texture_loader.h"
+#include "texture_atlas.h"
+#include "render_queue.h"
+#include "culling.h"
+#include "scene.h"
+#include "lod_selector.h"
+
+// shader의 uniform block Camera와 같은 std140 레이아웃
+struct CameraBlock {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+};
+static_assert(sizeof(CameraBlock) == sizeof(float) * 48, "CameraBlock must match std140 layout");
+
+// material 이미지(두번째 텍스처)를 올리는 방식
+enum class MaterialPacking {
+    None,  // material마다 텍스처 하나. material 수만큼 batch가 나뉜다
+    Atlas, // 2D atlas 하나에 모으고 uv 영역으로 구분
+    Array, // GL_TEXTURE_2D_ARRAY 하나의 layer로 쌓는다
+};
 
 CLASS_PTR(Context)
 class Context {
 public:
-    static ContextUPtr Create();
+    // objectCount가 10 이하이면 기본 배치, 그보다 많으면 카메라 앞에 무작위로 배치
+    // materialCount개의 material(두번째 텍스처)을 물체에 번갈아 할당. 첫번째는 awesomeface 이미지
+    // 나머지 material은 packing 방식으로 텍스처 하나에 모아 같은 batch로 그린다
+    static ContextUPtr Create(size_t objectCount = 10, size_t materialCount = 1,
+        MaterialPacking packing = MaterialPacking::Atlas);
     void Render();    
     void ProcessInput(GLFWwindow* window);
     void Reshape(int width, int height);
     void MouseMove(double x, double y);
     void MouseButton(int button, int action, double x, double y);
 
+    bool IsInstancing() const { return m_instancing; }
+    void SetInstancing(bool instancing) { m_instancing = instancing; }
+    // 애니메이션 시간 고정 (headless 렌더링용). nullopt이면 glfwGetTime 사용
+    void SetFixedTime(std::optional<double> time) { m_fixedTime = time; }
+    bool IsLoading() const { return m_textureLoader->GetPendingCount() > 0; }
+    size_t GetObjectCount() const { return m_culling->GetObjectCount(); }
+    size_t GetVisibleCount() const { return m_visibleObjects.size(); }
+    size_t GetMaterialCount() const { return m_materials.size(); }
+    // material이 사용하는 서로 다른 텍스처 수. LOD마다 이 수만큼 batch가 생긴다
+    size_t GetMaterialGroupCount() const { return m_materialGroups.size(); }
+
 private:
     Context() {}
-    bool Init();
-    ProgramUPtr m_program;
+    bool Init(size_t objectCount, size_t materialCount, MaterialPacking packing);
+    bool InitMaterials(size_t materialCount, MaterialPacking packing);
+    // program uniform 초기 값 설정. hot reload로 program이 교체된 뒤에도 호출
+    bool SetupPrograms();
+    void WatchSourceFiles();
+    void ReloadChangedFiles();
+
+    FileWatcherUPtr m_fileWatcher;
+    ShaderLibraryUPtr m_shaderLibrary;
+    // 물체별 draw / instanced draw program과 물체별 draw에서 매번 설정하는 uniform
+    struct ProgramSet {
+        ProgramPtr program;
+        ProgramPtr instanceProgram;
+        UniformHandle modelUniform;
+        UniformHandle uvRectUniform;
+        UniformHandle layerUniform;
+    };
+    // material 텍스처의 sampler 형식별. 0: sampler2D, 1: sampler2DArray (Array packing일 때만)
+    std::vector<ProgramSet> m_programSets;
 
-    VertexLayoutUPtr m_vertexLayout;
-    BufferUPtr m_vertexBuffer;
-    BufferUPtr m_indexBuffer;
-    TextureUPtr m_texture;
-    TextureUPtr m_texture2;
+    // 프레임 단위 uniform buffer
+    static constexpr uint32_t kCameraBinding = 0;
+    UniformBufferUPtr m_cameraBuffer;
+
+    RenderQueueUPtr m_renderQueue;
+
+    MeshStoragePtr m_meshStorage;
+    MeshUPtr m_mesh;
+    StreamBufferUPtr m_instanceStream;
+    TextureLoaderUPtr m_textureLoader;
+    TexturePtr m_texture;
+    TexturePtr m_texture2;
+    // 같은 텍스처를 쓰는 material 묶음. atlas / texture array에 모은 material은 한 group
+    struct MaterialGroup {
+        TexturePtr texture;
+        uint32_t programSet;
+    };
+    // material은 group과 그 텍스처 안의 영역. 0번은 m_texture2 전체
+    struct Material {
+        uint32_t group;
+        AtlasRegion region;
+    };
+    std::vector<MaterialGroup> m_materialGroups;
+    std::vector<Material> m_materials;
+    std::vector<uint32_t> m_objectMaterials;
+
+    // scene
+    JobSystemUPtr m_jobSystem;
+    SceneUPtr m_scene;
+    CullingSystemUPtr m_culling;
+    std::vector<uint32_t> m_visibleObjects;
+    float m_cubeRadius { 0.0f };
+
+    // LOD. 같은 (LOD, material group) 묶음이 한 batch
+    LodSelectorUPtr m_lodSelector;
+    std::vector<uint32_t> m_visibleBatches; // m_visibleObjects와 같은 순서의 batch 번호
+    std::vector<uint32_t> m_batchObjects;   // 보이는 물체를 batch 순서로 정렬한 목록
+    std::vector<uint32_t> m_batchStarts;    // batch별 m_batchObjects 내 시작 위치
+    std::vector<uint32_t> m_batchCursors;
+
+    // instancing. instance 데이터를 모을 때 job 하나가 처리할 물체 수
+    static constexpr size_t kInstanceGrainSize = 1024;
+    bool m_instancing { true };
+    std::vector<InstanceData> m_instances; // m_batchObjects와 같은 순서
 
     // camera parameter
+    static constexpr float kNearPlane = 0.01f;
+    static constexpr float kFarPlane = 50.0f;
     bool m_cameraControl { false };
     glm::vec2 m_prevMousePos { glm::vec2(0.0f) };
     float m_cameraPitch { 0.0f };
@@ -38,6 +136,8 @@ private:
     glm::vec3 m_cameraFront { glm::vec3(0.0f, 0.0f, -1.0f) };
     glm::vec3 m_cameraUp { glm::vec3(0.0f, 1.0f, 0.0f) };
     
+    std::optional<double> m_fixedTime;
+
     int m_width { WINDOW_WIDTH };
     int m_height { WINDOW_HEIGHT };
 };
@@ -0,0 +1,166 @@
+#include "culling.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CULLING_USE_SSE
+#include <emmintrin.h>
+#endif
+
+Frustum Frustum::FromMatrix(const glm::mat4& m) {
+    // glm은 column-major 이므로 i번째 행은 (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&m](int i) {
+        return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    };
+    Frustum frustum;
+    frustum.planes[Left] = row(3) + row(0);
+    frustum.planes[Right] = row(3) - row(0);
+    frustum.planes[Bottom] = row(3) + row(1);
+    frustum.planes[Top] = row(3) - row(1);
+    frustum.planes[Near] = row(3) + row(2);
+    frustum.planes[Far] = row(3) - row(2);
+    // 반지름과 비교할 수 있도록 법선을 정규화
+    for (auto& plane : frustum.planes)
+        plane /= glm::length(glm::vec3(plane));
+    return frustum;
+}
+
+CullingSystemUPtr CullingSystem::Create(size_t reserveCount) {
+    auto culling = CullingSystemUPtr(new CullingSystem());
+    culling->Init(reserveCount);
+    return std::move(culling);
+}
+
+bool CullingSystem::IsSimdSupported() {
+#ifdef CULLING_USE_SSE
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CullingSystem::Init(size_t reserveCount) {
+    for (auto array : { &m_centerX, &m_centerY, &m_centerZ,
+        &m_extentX, &m_extentY, &m_extentZ, &m_radius })
+        array->reserve(reserveCount);
+}
+
+uint32_t CullingSystem::Add(const glm::vec3& center, const glm::vec3& extents, float radius) {
+    m_centerX.push_back(center.x);
+    m_centerY.push_back(center.y);
+    m_centerZ.push_back(center.z);
+    m_extentX.push_back(extents.x);
+    m_extentY.push_back(extents.y);
+    m_extentZ.push_back(extents.z);
+    m_radius.push_back(radius);
+    return (uint32_t)m_centerX.size() - 1;
+}
+
+void CullingSystem::SetBounds(uint32_t index, const glm::vec3& center,
+    const glm::vec3& extents, float radius) {
+    m_centerX[index] = center.x;
+    m_centerY[index] = center.y;
+    m_centerZ[index] = center.z;
+    m_extentX[index] = extents.x;
+    m_extentY[index] = extents.y;
+    m_extentZ[index] = extents.z;
+    m_radius[index] = radius;
+}
+
+void CullingSystem::Clear() {
+    for (auto array : { &m_centerX, &m_centerY, &m_centerZ,
+        &m_extentX, &m_extentY, &m_extentZ, &m_radius })
+        array->clear();
+}
+
+size_t CullingSystem::Cull(const Frustum& frustum, std::vector<uint32_t>& visible,
+    Kernel kernel) const {
+    PROFILE_SCOPE("CullingSystem::Cull");
+    // 분기 없이 결과를 기록할 수 있도록 최대 개수만큼 미리 확보
+    visible.resize(GetObjectCount());
+    size_t count = 0;
+    if (kernel == Kernel::Simd && IsSimdSupported())
+        count = CullSimd(frustum, visible.data());
+    else
+        count = CullScalar(frustum, 0, visible.data());
+    visible.resize(count);
+    return count;
+}
+
+size_t CullingSystem::CullScalar(const Frustum& frustum, size_t begin, uint32_t* visible) const {
+    size_t count = 0;
+    size_t objectCount = GetObjectCount();
+    for (size_t i = begin; i < objectCount; i++) {
+        bool inside = true;
+        for (auto& plane : frustum.planes) {
+            // 덧셈 순서까지 SIMD 경로와 같게 묶어야 경계에서 반올림 결과가 일치한다
+            // distance = (x + y) + (z + w), boxRadius = (x + y) + z
+            float distance = (plane.x * m_centerX[i] + plane.y * m_centerY[i]) +
+                (plane.z * m_centerZ[i] + plane.w);
+            float boxRadius = (std::abs(plane.x) * m_extentX[i] + std::abs(plane.y) * m_extentY[i]) +
+                std::abs(plane.z) * m_extentZ[i];
+            inside &= distance + std::min(boxRadius, m_radius[i]) >= 0.0f;
+        }
+        visible[count] = (uint32_t)i;
+        count += inside ? 1 : 0;
+    }
+    return count;
+}
+
+size_t CullingSystem::CullSimd(const Frustum& frustum, uint32_t* visible) const {
+#ifdef CULLING_USE_SSE
+    // 평면 계수는 루프 밖에서 4개 lane으로 복제해 둔다
+    __m128 planeX[Frustum::Count], planeY[Frustum::Count];
+    __m128 planeZ[Frustum::Count], planeW[Frustum::Count];
+    __m128 absX[Frustum::Count], absY[Frustum::Count], absZ[Frustum::Count];
+    for (int p = 0; p < Frustum::Count; p++) {
+        auto& plane = frustum.planes[p];
+        planeX[p] = _mm_set1_ps(plane.x);
+        planeY[p] = _mm_set1_ps(plane.y);
+        planeZ[p] = _mm_set1_ps(plane.z);
+        planeW[p] = _mm_set1_ps(plane.w);
+        absX[p] = _mm_set1_ps(std::abs(plane.x));
+        absY[p] = _mm_set1_ps(std::abs(plane.y));
+        absZ[p] = _mm_set1_ps(std::abs(plane.z));
+    }
+
+    size_t count = 0;
+    size_t objectCount = GetObjectCount();
+    size_t simdCount = objectCount & ~(size_t)3;
+    const __m128 zero = _mm_setzero_ps();
+    for (size_t i = 0; i < simdCount; i += 4) {
+        __m128 centerX = _mm_loadu_ps(m_centerX.data() + i);
+        __m128 centerY = _mm_loadu_ps(m_centerY.data() + i);
+        __m128 centerZ = _mm_loadu_ps(m_centerZ.data() + i);
+        __m128 extentX = _mm_loadu_ps(m_extentX.data() + i);
+        __m128 extentY = _mm_loadu_ps(m_extentY.data() + i);
+        __m128 extentZ = _mm_loadu_ps(m_extentZ.data() + i);
+        __m128 radius = _mm_loadu_ps(m_radius.data() + i);
+
+        __m128 outside = zero;
+        for (int p = 0; p < Frustum::Count; p++) {
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(planeX[p], centerX), _mm_mul_ps(planeY[p], centerY)),
+                _mm_add_ps(_mm_mul_ps(planeZ[p], centerZ), planeW[p]));
+            __m128 boxRadius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(absX[p], extentX), _mm_mul_ps(absY[p], extentY)),
+                _mm_mul_ps(absZ[p], extentZ));
+            // distance + r < 0 이면 평면 밖
+            __m128 r = _mm_min_ps(boxRadius, radius);
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, r), zero));
+        }
+
+        // 보이는 lane의 index만 앞으로 모아서 기록 (branchless compaction)
+        int mask = ~_mm_movemask_ps(outside);
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            visible[count] = (uint32_t)i + lane;
+            count += (mask >> lane) & 1;
+        }
+    }
+    // 4개 단위로 나누어 떨어지지 않는 나머지
+    return count + CullScalar(frustum, simdCount, visible + count);
+#else
+    return CullScalar(frustum, 0, visible);
+#endif
+}
@@ -0,0 +1,65 @@
+#ifndef __CULLING_H__
+#define __CULLING_H__
+
+#include "common.h"
+#include <vector>
+
+// view frustum의 6개 평면. (a, b, c, d)에 대해 ax + by + cz + d >= 0 이면 안쪽
+struct Frustum {
+    enum Plane { Left, Right, Bottom, Top, Near, Far, Count };
+    glm::vec4 planes[Count];
+
+    // projection * view 행렬의 행 조합으로 world space 평면을 구한다 (Gribb-Hartmann)
+    static Frustum FromMatrix(const glm::mat4& viewProjection);
+};
+
+/*
+    CPU frustum culling
+    물체의 bounding volume(중심, AABB 반지름, bounding sphere 반지름)을
+    structure-of-arrays로 저장하여 SIMD로 4개씩 한번에 검사한다.
+    각 평면에 대해 AABB / sphere 중 더 작은 투영 반지름을 사용하므로
+    두 볼륨 중 하나라도 평면 밖에 있으면 컬링된다.
+*/
+CLASS_PTR(CullingSystem)
+class CullingSystem {
+public:
+    enum class Kernel {
+        Scalar,
+        Simd,
+    };
+
+    static CullingSystemUPtr Create(size_t reserveCount = 1024);
+
+    // 지원하지 않는 환경에서는 Simd를 요청해도 scalar 경로를 사용
+    static bool IsSimdSupported();
+
+    // 물체를 등록하고 object index를 돌려준다. extents는 AABB의 반 크기
+    uint32_t Add(const glm::vec3& center, const glm::vec3& extents, float radius);
+    uint32_t Add(const glm::vec3& center, float radius) {
+        return Add(center, glm::vec3(radius), radius);
+    }
+    void SetBounds(uint32_t index, const glm::vec3& center,
+        const glm::vec3& extents, float radius);
+    void Clear();
+    size_t GetObjectCount() const { return m_centerX.size(); }
+
+    // frustum과 겹치는 물체의 index를 오름차순으로 visible에 기록하고 개수를 돌려준다
+    size_t Cull(const Frustum& frustum, std::vector<uint32_t>& visible,
+        Kernel kernel = Kernel::Simd) const;
+
+private:
+    CullingSystem() {}
+    void Init(size_t reserveCount);
+    size_t CullScalar(const Frustum& frustum, size_t begin, uint32_t* visible) const;
+    size_t CullSimd(const Frustum& frustum, uint32_t* visible) const;
+
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_extentX;
+    std::vector<float> m_extentY;
+    std::vector<float> m_extentZ;
+    std::vector<float> m_radius;
+};
+
+#endif // __CULLING_H__
@@ -0,0 +1,126 @@
+#include "file_watcher.h"
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+FileWatcherUPtr FileWatcher::Create() {
+    auto watcher = FileWatcherUPtr(new FileWatcher());
+    if (!watcher->Init())
+        return nullptr;
+    return std::move(watcher);
+}
+
+#ifdef __linux__
+bool FileWatcher::Init() {
+    m_inotify = inotify_init1(IN_CLOEXEC);
+    if (m_inotify < 0) {
+        SPDLOG_ERROR("failed to initialize inotify");
+        return false;
+    }
+    // 소멸 시 blocking 중인 thread를 깨우기 위한 pipe
+    if (pipe(m_wakePipe) != 0) {
+        SPDLOG_ERROR("failed to create file watcher pipe");
+        return false;
+    }
+    m_thread = std::thread([this]() { Run(); });
+    return true;
+}
+
+FileWatcher::~FileWatcher() {
+    if (m_thread.joinable()) {
+        char wake = 0;
+        if (write(m_wakePipe[1], &wake, 1) < 0)
+            SPDLOG_ERROR("failed to stop file watcher");
+        m_thread.join();
+    }
+    for (int fd : m_wakePipe) {
+        if (fd >= 0)
+            close(fd);
+    }
+    if (m_inotify >= 0)
+        close(m_inotify);
+}
+
+bool FileWatcher::Watch(const std::string& filepath) {
+    auto file = NormalizePath(filepath);
+    auto directory = fs::path(file).parent_path().generic_string();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_files.insert(file).second)
+        return true;
+    for (auto& watched : m_directories) {
+        if (watched.second == directory)
+            return true;
+    }
+    int wd = inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        SPDLOG_ERROR("failed to watch directory: {}", directory);
+        m_files.erase(file);
+        return false;
+    }
+    m_directories[wd] = directory;
+    return true;
+}
+
+void FileWatcher::Run() {
+    // inotify_event는 가변 길이. 여러 이벤트가 한번에 읽힌다
+    alignas(inotify_event) char buffer[4096];
+    pollfd fds[2] = {
+        { m_inotify, POLLIN, 0 },
+        { m_wakePipe[0], POLLIN, 0 },
+    };
+    while (true) {
+        if (poll(fds, 2, -1) < 0)
+            continue;
+        if (fds[1].revents)
+            break;
+        ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+        if (length <= 0)
+            continue;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (ssize_t offset = 0; offset < length;) {
+            auto event = (const inotify_event*)(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            auto directory = m_directories.find(event->wd);
+            if (event->len == 0 || directory == m_directories.end())
+                continue;
+            auto file = directory->second + "/" + event->name;
+            // 감시 중인 디렉토리의 다른 파일 변경은 무시
+            if (m_files.find(file) == m_files.end())
+                continue;
+            m_changes.insert(file);
+            m_hasChanges.store(true, std::memory_order_release);
+        }
+    }
+}
+#else
+bool FileWatcher::Init() {
+    SPDLOG_INFO("file watcher is not supported on this platform");
+    return true;
+}
+
+FileWatcher::~FileWatcher() {
+}
+
+bool FileWatcher::Watch([[maybe_unused]] const std::string& filepath) {
+    return false;
+}
+
+void FileWatcher::Run() {
+}
+#endif
+
+std::vector<std::string> FileWatcher::TakeChanges() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hasChanges.store(false, std::memory_order_release);
+    std::vector<std::string> changes(m_changes.begin(), m_changes.end());
+    m_changes.clear();
+    return changes;
+}
@@ -0,0 +1,48 @@
+#ifndef __FILE_WATCHER_H__
+#define __FILE_WATCHER_H__
+
+#include "common.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+    파일 변경 감시 (hot reload 용)
+    Linux에서는 inotify로 파일이 있는 디렉토리를 감시한다. 에디터는 보통 임시 파일에 쓴 뒤
+    rename 하므로 파일 자체가 아닌 디렉토리의 IN_CLOSE_WRITE / IN_MOVED_TO를 본다
+    이벤트는 백그라운드 thread에서 blocking read로 받으므로 변경이 없을 때
+    GL thread에서 드는 비용은 HasChanges()의 atomic load 하나뿐이다
+    그 외 플랫폼에서는 아무 변경도 보고하지 않는다
+*/
+CLASS_PTR(FileWatcher)
+class FileWatcher {
+public:
+    static FileWatcherUPtr Create();
+    ~FileWatcher();
+
+    // 같은 파일을 여러번 등록해도 된다
+    bool Watch(const std::string& filepath);
+
+    bool HasChanges() const { return m_hasChanges.load(std::memory_order_acquire); }
+    // 마지막 호출 이후 변경된 파일 목록 (NormalizePath 형식)
+    std::vector<std::string> TakeChanges();
+
+private:
+    FileWatcher() {}
+    bool Init();
+    void Run();
+
+    int m_inotify { -1 };
+    int m_wakePipe[2] { -1, -1 };
+    std::thread m_thread;
+
+    std::mutex m_mutex;
+    std::unordered_map<int, std::string> m_directories; // watch descriptor -> 디렉토리
+    std::unordered_set<std::string> m_files;
+    std::unordered_set<std::string> m_changes;
+    std::atomic<bool> m_hasChanges { false };
+};
+
+#endif // __FILE_WATCHER_H__
@@ -0,0 +1,113 @@
+#include "frame_reader.h"
+#include "profiler.h"
+#include "render_state.h"
+#include <cstring>
+#include <filesystem>
+
+FrameReaderUPtr FrameReader::Create(int width, int height,
+    const std::string& outputDirectory, size_t bufferCount) {
+    auto reader = FrameReaderUPtr(new FrameReader());
+    if (!reader->Init(width, height, outputDirectory, bufferCount))
+        return nullptr;
+    return std::move(reader);
+}
+
+FrameReader::~FrameReader() {
+    Flush();
+}
+
+bool FrameReader::Init(int width, int height,
+    const std::string& outputDirectory, size_t bufferCount) {
+    m_width = width;
+    m_height = height;
+    m_outputDirectory = outputDirectory;
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_outputDirectory, ec);
+    if (ec) {
+        SPDLOG_ERROR("failed to create output directory: {}", m_outputDirectory);
+        return false;
+    }
+
+    size_t frameSize = (size_t)m_width * m_height * 4;
+    for (size_t i = 0; i < bufferCount; i++) {
+        Slot slot;
+        slot.buffer = Buffer::CreateWithData(GL_PIXEL_PACK_BUFFER, GL_STREAM_READ,
+            nullptr, frameSize);
+        if (!slot.buffer)
+            return false;
+        m_slots.push_back(std::move(slot));
+    }
+    RenderState::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    // 인코딩은 CPU 부하가 크므로 GL thread를 위해 코어 하나는 남겨둔다
+    // hardware_concurrency()는 알 수 없으면 0이므로 최소 한 thread는 보장
+    m_encoder = ThreadPool::Create(std::max(2u, std::thread::hardware_concurrency()) - 1);
+    return true;
+}
+
+void FrameReader::Capture(uint32_t frameIndex) {
+    PROFILE_SCOPE("FrameReader::Capture");
+    auto& slot = m_slots[m_slotIndex];
+    m_slotIndex = (m_slotIndex + 1) % m_slots.size();
+    // 이 슬롯을 다시 쓰기 전에 이전 내용을 처리 (bufferCount 프레임 전의 readback)
+    if (slot.fence)
+        Resolve(slot);
+
+    slot.buffer->Bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    // PBO가 바인딩되어 있으므로 마지막 인자는 버퍼 내 offset. 바로 리턴된다
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    RenderState::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.frameIndex = frameIndex;
+
+    CollectJobs(false);
+}
+
+void FrameReader::Resolve(Slot& slot) {
+    PROFILE_SCOPE("FrameReader::Resolve");
+    glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    auto image = Image::Create(m_width, m_height, 4);
+    size_t frameSize = (size_t)m_width * m_height * 4;
+    auto ptr = slot.buffer->Map(0, frameSize, GL_MAP_READ_BIT);
+    if (!ptr) {
+        SPDLOG_ERROR("failed to map pixel pack buffer");
+        RenderState::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return;
+    }
+    memcpy(image->GetData(), ptr, frameSize);
+    slot.buffer->Unmap();
+    RenderState::Get().BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    auto filename = fmt::format("{}/frame_{:05d}.png", m_outputDirectory, slot.frameIndex);
+    // glReadPixels 결과는 아래쪽 행부터 저장되어 있으므로 뒤집어서 저장
+    m_jobs.push_back(m_encoder->Submit([image = std::shared_ptr<Image>(std::move(image)), filename]() {
+        PROFILE_SCOPE("FrameReader::Encode");
+        return image->Save(filename, true);
+    }));
+}
+
+void FrameReader::CollectJobs(bool wait) {
+    for (auto it = m_jobs.begin(); it != m_jobs.end();) {
+        if (!wait && it->wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        if (it->get())
+            m_savedCount++;
+        it = m_jobs.erase(it);
+    }
+}
+
+void FrameReader::Flush() {
+    // 캡쳐한 순서대로 처리
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        auto& slot = m_slots[(m_slotIndex + i) % m_slots.size()];
+        if (slot.fence)
+            Resolve(slot);
+    }
+    CollectJobs(true);
+}
@@ -0,0 +1,49 @@
+#ifndef __FRAME_READER_H__
+#define __FRAME_READER_H__
+
+#include "buffer.h"
+#include "image.h"
+#include "thread_pool.h"
+
+/*
+    렌더링 결과를 GL_PIXEL_PACK_BUFFER로 비동기 readback 하여 파일로 저장
+    glReadPixels는 PBO로 복사 명령만 넣고 바로 리턴하며,
+    PBO 내용은 몇 프레임 뒤 (fence 완료 후) map 하여 읽는다.
+    PNG 인코딩과 파일 쓰기는 worker thread에서 수행한다.
+*/
+CLASS_PTR(FrameReader)
+class FrameReader {
+public:
+    static FrameReaderUPtr Create(int width, int height,
+        const std::string& outputDirectory, size_t bufferCount = 3);
+    ~FrameReader();
+
+    // 현재 바인딩된 read framebuffer의 내용을 frameIndex 프레임으로 캡쳐
+    void Capture(uint32_t frameIndex);
+    // 남은 readback과 인코딩 작업을 모두 끝낸다
+    void Flush();
+    size_t GetSavedCount() const { return m_savedCount; }
+
+private:
+    FrameReader() {}
+    bool Init(int width, int height, const std::string& outputDirectory, size_t bufferCount);
+
+    struct Slot {
+        BufferUPtr buffer;
+        GLsync fence { nullptr };
+        uint32_t frameIndex { 0 };
+    };
+    void Resolve(Slot& slot);
+    void CollectJobs(bool wait);
+
+    int m_width { 0 };
+    int m_height { 0 };
+    std::string m_outputDirectory;
+    std::vector<Slot> m_slots;
+    size_t m_slotIndex { 0 };
+    ThreadPoolUPtr m_encoder;
+    std::vector<std::future<bool>> m_jobs;
+    size_t m_savedCount { 0 };
+};
+
+#endif // __FRAME_READER_H__
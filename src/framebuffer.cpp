@@ -0,0 +1,51 @@
+#include "framebuffer.h"
+
+FramebufferUPtr Framebuffer::Create(int width, int height) {
+    auto framebuffer = FramebufferUPtr(new Framebuffer());
+    if (!framebuffer->Init(width, height))
+        return nullptr;
+    return std::move(framebuffer);
+}
+
+void Framebuffer::BindToDefault() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+Framebuffer::~Framebuffer() {
+    if (m_depthStencilBuffer) {
+        glDeleteRenderbuffers(1, &m_depthStencilBuffer);
+    }
+    if (m_framebuffer) {
+        glDeleteFramebuffers(1, &m_framebuffer);
+    }
+}
+
+void Framebuffer::Bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+}
+
+bool Framebuffer::Init(int width, int height) {
+    m_colorAttachment = Texture::Create(width, height, GL_RGBA);
+    // mipmap이 없는 텍스처이므로 mipmap 필터를 사용하지 않음
+    m_colorAttachment->SetFilter(GL_LINEAR, GL_LINEAR);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    Bind();
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D, m_colorAttachment->Get(), 0);
+
+    glGenRenderbuffers(1, &m_depthStencilBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthStencilBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+        GL_RENDERBUFFER, m_depthStencilBuffer);
+
+    auto result = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (result != GL_FRAMEBUFFER_COMPLETE) {
+        SPDLOG_ERROR("failed to create framebuffer: {}", result);
+        return false;
+    }
+    BindToDefault();
+    return true;
+}
@@ -0,0 +1,28 @@
+#ifndef __FRAMEBUFFER_H__
+#define __FRAMEBUFFER_H__
+
+#include "texture.h"
+
+// 색상 텍스처 + depth renderbuffer로 구성된 오프스크린 렌더 타겟
+CLASS_PTR(Framebuffer)
+class Framebuffer {
+public:
+    static FramebufferUPtr Create(int width, int height);
+    static void BindToDefault();
+    ~Framebuffer();
+
+    uint32_t Get() const { return m_framebuffer; }
+    int GetWidth() const { return m_colorAttachment->GetWidth(); }
+    int GetHeight() const { return m_colorAttachment->GetHeight(); }
+    const Texture* GetColorAttachment() const { return m_colorAttachment.get(); }
+    void Bind() const;
+
+private:
+    Framebuffer() {}
+    bool Init(int width, int height);
+    uint32_t m_framebuffer { 0 };
+    uint32_t m_depthStencilBuffer { 0 };
+    TextureUPtr m_colorAttachment;
+};
+
+#endif // __FRAMEBUFFER_H__
@@ -1,7 +1,17 @@
 #include "image.h"
+#include "image_ops.h"
+#include "mapped_file.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image_write.h>
 
 ImageUPtr Image::Load(const std::string& filepath) {
     auto image = ImageUPtr(new Image());
@@ -23,9 +33,49 @@ Image::~Image() {
     }
 }
 
+bool Image::Save(const std::string& filepath, bool flipVertical) const {
+    PROFILE_SCOPE("Image::Save");
+    auto extension = fs::path(filepath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    int stride = m_width * m_channelCount;
+    bool saved = false;
+    if (extension == ".jpg" || extension == ".jpeg") {
+        // jpg writer는 stride를 받지 않으므로 뒤집은 사본을 저장
+        // (stbi_flip_vertically_on_write는 전역 설정이라 여러 thread에서 쓸 수 없음)
+        const uint8_t* data = m_data;
+        std::vector<uint8_t> flipped;
+        if (flipVertical) {
+            flipped.resize((size_t)stride * m_height);
+            for (int j = 0; j < m_height; j++)
+                memcpy(flipped.data() + (size_t)j * stride, m_data + (size_t)(m_height - 1 - j) * stride, stride);
+            data = flipped.data();
+        }
+        saved = stbi_write_jpg(filepath.c_str(), m_width, m_height, m_channelCount, data, 90);
+    }
+    else {
+        // 음수 stride를 주면 마지막 행부터 거꾸로 기록된다
+        const uint8_t* data = flipVertical ? m_data + stride * (m_height - 1) : m_data;
+        saved = stbi_write_png(filepath.c_str(), m_width, m_height, m_channelCount,
+            data, flipVertical ? -stride : stride);
+    }
+    if (!saved) {
+        SPDLOG_ERROR("failed to save image: {}", filepath);
+        return false;
+    }
+    return true;
+}
+
 bool Image::LoadWithStb(const std::string& filepath) {
-    stbi_set_flip_vertically_on_load(true); // 이미지 로딩시 상하를 반전
-    m_data = stbi_load(filepath.c_str(), &m_width, &m_height, &m_channelCount, 0);
+    PROFILE_SCOPE("Image::LoadWithStb");
+    // 이미지 로딩시 상하를 반전
+    // worker thread에서 동시에 로딩할 수 있도록 thread local 설정을 사용
+    stbi_set_flip_vertically_on_load_thread(true);
+    // 파일을 매핑하여 중간 버퍼 복사 없이 디코딩
+    auto file = MappedFile::Open(filepath);
+    if (!file)
+        return false;
+    m_data = stbi_load_from_memory(file->GetData(), (int)file->GetSize(),
+        &m_width, &m_height, &m_channelCount, 0);
     if (!m_data) {
         SPDLOG_ERROR("failed to load image: {}", filepath);
         return false;
@@ -41,30 +91,10 @@ bool Image::Allocate(int width, int height, int channelCount) {
     return m_data ? true : false;
 }
 
-/*
-ex) gridX = 4; gridY = 4
-
-0 0 0 0 1 1 1 1 0 0 0 0 
-0 0 0 0 1 1 1 1 0 0 0 0 
-0 0 0 0 1 1 1 1 0 0 0 0 
-0 0 0 0 1 1 1 1 0 0 0 0 
-1 1 1 1 0 0 0 0 1 1 1 1
-1 1 1 1 0 0 0 0 1 1 1 1
-1 1 1 1 0 0 0 0 1 1 1 1
-1 1 1 1 0 0 0 0 1 1 1 1
-...
-
-*/
 void Image::SetCheckImage(int gridX, int gridY) {
-    for (int j = 0; j < m_height; j++) {
-        for (int i = 0; i < m_width; i++) {
-            int pos = (j * m_width + i) * m_channelCount;
-            bool even = ((i / gridX) + (j / gridY)) % 2 == 0;
-            uint8_t value = even ? 255 : 0;
-            for (int k = 0; k < m_channelCount; k++)
-                m_data[pos + k] = value;
-            if (m_channelCount > 3)
-                m_data[3] = 255;
-        }
-    }
-}
\ No newline at end of file
+    ImageOps::FillChecker(this, gridX, gridY);
+}
+
+ImageUPtr Image::Downsample() const {
+    return ImageOps::Downsample(this, ImageOps::MipFilter::Box);
+}
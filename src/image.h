@@ -10,12 +10,20 @@ public:
     static ImageUPtr Create(int width, int height, int channelCount = 4);
     ~Image();
 
+    // 확장자가 .jpg / .jpeg이면 JPEG, 그 외에는 PNG로 저장
+    // flipVertical이면 아래쪽 행부터 저장 (glReadPixels 결과 등)
+    bool Save(const std::string& filepath, bool flipVertical = false) const;
+
     const uint8_t* GetData() const { return m_data; }
+    uint8_t* GetData() { return m_data; }
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
     int GetChannelCount() const { return m_channelCount; }
 
+    // 이미지 처리는 ImageOps의 kernel을 사용 (image_ops.h)
     void SetCheckImage(int gridX, int gridY);
+    // 가로 세로 절반 크기의 다음 mip 레벨 이미지 생성 (2x2 box filter)
+    ImageUPtr Downsample() const;
 
 private:
     Image() {};
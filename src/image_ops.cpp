@@ -0,0 +1,799 @@
+#include "image_ops.h"
+#include "profiler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_OPS_USE_SSE
+#include <emmintrin.h>
+#endif
+
+// AVX2는 기본 컴파일 옵션에 없으므로 함수 단위로 target을 지정하고 실행 시점에 확인
+#if defined(IMAGE_OPS_USE_SSE) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IMAGE_OPS_USE_AVX2
+#define IMAGE_OPS_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(IMAGE_OPS_USE_SSE) && defined(__AVX2__)
+#define IMAGE_OPS_USE_AVX2
+#define IMAGE_OPS_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+namespace ImageOps {
+
+bool IsKernelSupported(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::Scalar:
+        return true;
+    case Kernel::Sse2:
+#ifdef IMAGE_OPS_USE_SSE
+        return true;
+#else
+        return false;
+#endif
+    case Kernel::Avx2:
+#if defined(IMAGE_OPS_USE_AVX2) && defined(__GNUC__)
+        return __builtin_cpu_supports("avx2");
+#elif defined(IMAGE_OPS_USE_AVX2)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+Kernel ResolveKernel(Kernel kernel) {
+    if (kernel == Kernel::Avx2 && !IsKernelSupported(Kernel::Avx2))
+        kernel = Kernel::Sse2;
+    if (kernel == Kernel::Sse2 && !IsKernelSupported(Kernel::Sse2))
+        kernel = Kernel::Scalar;
+    return kernel;
+}
+
+const char* GetKernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::Scalar: return "scalar";
+    case Kernel::Sse2: return "sse2";
+    case Kernel::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+static size_t GetPixelCount(const Image* image) {
+    return (size_t)image->GetWidth() * image->GetHeight();
+}
+
+static uint32_t LoadPixel(const uint8_t* src) {
+    uint32_t pixel;
+    memcpy(&pixel, src, 4);
+    return pixel;
+}
+
+// RGBA 픽셀의 alpha 위치 (little endian)
+static constexpr uint32_t kAlphaMask = 0xff000000u;
+
+/*
+    채우기
+    SIMD 경로는 같은 값이 이어지는 구간을 vector store로 채운다
+*/
+static void FillRunScalar(uint8_t* dst, size_t count, uint32_t pixel) {
+    for (size_t i = 0; i < count; i++)
+        memcpy(dst + i * 4, &pixel, 4);
+}
+
+#ifdef IMAGE_OPS_USE_SSE
+static void FillRunSse2(uint8_t* dst, size_t count, uint32_t pixel) {
+    __m128i value = _mm_set1_epi32((int)pixel);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128((__m128i*)(dst + i * 4), value);
+    FillRunScalar(dst + i * 4, count - i, pixel);
+}
+#endif
+
+#ifdef IMAGE_OPS_USE_AVX2
+IMAGE_OPS_AVX2_TARGET
+static void FillRunAvx2(uint8_t* dst, size_t count, uint32_t pixel) {
+    __m256i value = _mm256_set1_epi32((int)pixel);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), value);
+    FillRunScalar(dst + i * 4, count - i, pixel);
+}
+#endif
+
+using FillRunFunc = void (*)(uint8_t*, size_t, uint32_t);
+
+// RGBA가 아니면 scalar
+static FillRunFunc GetFillRun(const Image* image, Kernel kernel) {
+    if (image->GetChannelCount() != 4)
+        return nullptr;
+    switch (ResolveKernel(kernel)) {
+#ifdef IMAGE_OPS_USE_AVX2
+    case Kernel::Avx2: return FillRunAvx2;
+#endif
+#ifdef IMAGE_OPS_USE_SSE
+    case Kernel::Sse2: return FillRunSse2;
+#endif
+    default: return nullptr;
+    }
+}
+
+void FillSolid(Image* image, const uint8_t* color, Kernel kernel) {
+    PROFILE_SCOPE("ImageOps::FillSolid");
+    auto fillRun = GetFillRun(image, kernel);
+    if (fillRun) {
+        fillRun(image->GetData(), GetPixelCount(image), LoadPixel(color));
+        return;
+    }
+    int channelCount = image->GetChannelCount();
+    uint8_t* data = image->GetData();
+    size_t pixelCount = GetPixelCount(image);
+    for (size_t i = 0; i < pixelCount; i++) {
+        for (int k = 0; k < channelCount; k++)
+            data[i * channelCount + k] = color[k];
+    }
+}
+
+/*
+ex) gridX = 4; gridY = 4
+
+0 0 0 0 1 1 1 1 0 0 0 0
+0 0 0 0 1 1 1 1 0 0 0 0
+0 0 0 0 1 1 1 1 0 0 0 0
+0 0 0 0 1 1 1 1 0 0 0 0
+1 1 1 1 0 0 0 0 1 1 1 1
+1 1 1 1 0 0 0 0 1 1 1 1
+1 1 1 1 0 0 0 0 1 1 1 1
+1 1 1 1 0 0 0 0 1 1 1 1
+...
+
+*/
+void FillChecker(Image* image, int gridX, int gridY, Kernel kernel) {
+    PROFILE_SCOPE("ImageOps::FillChecker");
+    if (gridX <= 0 || gridY <= 0) {
+        SPDLOG_ERROR("invalid checker grid: {}x{}", gridX, gridY);
+        return;
+    }
+    int width = image->GetWidth();
+    int height = image->GetHeight();
+    int channelCount = image->GetChannelCount();
+    uint8_t* data = image->GetData();
+
+    auto fillRun = GetFillRun(image, kernel);
+    if (fillRun) {
+        // 한 행에서 gridX 픽셀씩 같은 값
+        for (int j = 0; j < height; j++) {
+            uint8_t* row = data + (size_t)j * width * 4;
+            for (int i = 0; i < width; i += gridX) {
+                bool even = ((i / gridX) + (j / gridY)) % 2 == 0;
+                fillRun(row + (size_t)i * 4, std::min(gridX, width - i),
+                    even ? 0xffffffffu : kAlphaMask);
+            }
+        }
+        return;
+    }
+
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            size_t pos = ((size_t)j * width + i) * channelCount;
+            bool even = ((i / gridX) + (j / gridY)) % 2 == 0;
+            uint8_t value = even ? 255 : 0;
+            for (int k = 0; k < channelCount; k++)
+                data[pos + k] = value;
+            if (channelCount > 3)
+                data[pos + 3] = 255;
+        }
+    }
+}
+
+/*
+    RGBA 확장
+*/
+static void ExpandScalar(const uint8_t* src, uint8_t* dst, size_t pixelCount, int channelCount) {
+    for (size_t i = 0; i < pixelCount; i++) {
+        const uint8_t* s = src + i * channelCount;
+        uint8_t* d = dst + i * 4;
+        switch (channelCount) {
+        case 1: d[0] = s[0]; d[1] = s[0]; d[2] = s[0]; d[3] = 255; break;
+        case 2: d[0] = s[0]; d[1] = s[0]; d[2] = s[0]; d[3] = s[1]; break;
+        case 3: d[0] = s[0]; d[1] = s[1]; d[2] = s[2]; d[3] = 255; break;
+        default: memcpy(d, s, 4); break;
+        }
+    }
+}
+
+#ifdef IMAGE_OPS_USE_SSE
+// RGB 4픽셀(12byte)을 4byte씩 읽어 alpha를 덮어쓴다. 마지막 픽셀 다음 1byte까지 읽으므로 끝은 scalar
+static void ExpandRgbSse2(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    const __m128i alpha = _mm_set1_epi32((int)kAlphaMask);
+    size_t i = 0;
+    for (; i + 5 <= pixelCount; i += 4) {
+        const uint8_t* s = src + i * 3;
+        __m128i value = _mm_set_epi32((int)LoadPixel(s + 9), (int)LoadPixel(s + 6),
+            (int)LoadPixel(s + 3), (int)LoadPixel(s));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(value, alpha));
+    }
+    ExpandScalar(src + i * 3, dst + i * 4, pixelCount - i, 3);
+}
+#endif
+
+#ifdef IMAGE_OPS_USE_AVX2
+// RGB 8픽셀(24byte)을 32byte로 읽어 lane 마다 12byte씩 나눈 뒤 byte shuffle
+IMAGE_OPS_AVX2_TARGET
+static void ExpandRgbAvx2(const uint8_t* src, uint8_t* dst, size_t pixelCount) {
+    const __m256i alpha = _mm256_set1_epi32((int)kAlphaMask);
+    const __m256i split = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+    const __m256i shuffle = _mm256_setr_epi8(
+        0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+        0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    size_t i = 0;
+    for (; (pixelCount - i) * 3 >= 32; i += 8) {
+        __m256i value = _mm256_loadu_si256((const __m256i*)(src + i * 3));
+        value = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(value, split), shuffle);
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(value, alpha));
+    }
+    ExpandScalar(src + i * 3, dst + i * 4, pixelCount - i, 3);
+}
+#endif
+
+ImageUPtr ExpandToRgba(const Image* image, Kernel kernel) {
+    PROFILE_SCOPE("ImageOps::ExpandToRgba");
+    auto result = Image::Create(image->GetWidth(), image->GetHeight(), 4);
+    if (!result)
+        return nullptr;
+    const uint8_t* src = image->GetData();
+    uint8_t* dst = result->GetData();
+    size_t pixelCount = GetPixelCount(image);
+    int channelCount = image->GetChannelCount();
+    if (channelCount == 4) {
+        memcpy(dst, src, pixelCount * 4);
+        return std::move(result);
+    }
+
+    // SIMD 경로는 가장 흔한 RGB (jpg 등)만
+    switch (channelCount == 3 ? ResolveKernel(kernel) : Kernel::Scalar) {
+#ifdef IMAGE_OPS_USE_AVX2
+    case Kernel::Avx2: ExpandRgbAvx2(src, dst, pixelCount); break;
+#endif
+#ifdef IMAGE_OPS_USE_SSE
+    case Kernel::Sse2: ExpandRgbSse2(src, dst, pixelCount); break;
+#endif
+    default: ExpandScalar(src, dst, pixelCount, channelCount); break;
+    }
+    return std::move(result);
+}
+
+/*
+    premultiplied alpha
+    x = c * a + 128, (x + (x >> 8)) >> 8 == round(c * a / 255)
+    모든 중간값이 16bit 안에 들어가므로 SIMD는 16bit lane에서 같은 식을 계산한다
+    alpha lane에는 255를 곱해서 값이 그대로 유지된다
+*/
+static uint8_t MultiplyAlpha(uint32_t c, uint32_t a) {
+    uint32_t x = c * a + 128;
+    return (uint8_t)((x + (x >> 8)) >> 8);
+}
+
+static void PremultiplyScalar(uint8_t* data, size_t pixelCount, int channelCount) {
+    for (size_t i = 0; i < pixelCount; i++) {
+        uint8_t* p = data + i * channelCount;
+        uint8_t a = p[channelCount - 1];
+        for (int k = 0; k < channelCount - 1; k++)
+            p[k] = MultiplyAlpha(p[k], a);
+    }
+}
+
+#ifdef IMAGE_OPS_USE_SSE
+static __m128i PremultiplySse2(__m128i value) {
+    const __m128i rgbMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaLane = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i bias = _mm_set1_epi16(128);
+    // alpha를 같은 픽셀의 4개 lane으로 복제
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(value, 0xff), 0xff);
+    __m128i factor = _mm_or_si128(_mm_and_si128(alpha, rgbMask), alphaLane);
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(value, factor), bias);
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static void PremultiplyRgbaSse2(uint8_t* data, size_t pixelCount) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i value = _mm_loadu_si128((const __m128i*)(data + i * 4));
+        __m128i lo = PremultiplySse2(_mm_unpacklo_epi8(value, zero));
+        __m128i hi = PremultiplySse2(_mm_unpackhi_epi8(value, zero));
+        _mm_storeu_si128((__m128i*)(data + i * 4), _mm_packus_epi16(lo, hi));
+    }
+    PremultiplyScalar(data + i * 4, pixelCount - i, 4);
+}
+#endif
+
+#ifdef IMAGE_OPS_USE_AVX2
+IMAGE_OPS_AVX2_TARGET
+static __m256i PremultiplyAvx2(__m256i value) {
+    const __m256i rgbMask = _mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1,
+        0, -1, -1, -1, 0, -1, -1, -1);
+    const __m256i alphaLane = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0,
+        255, 0, 0, 0, 255, 0, 0, 0);
+    const __m256i bias = _mm256_set1_epi16(128);
+    __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(value, 0xff), 0xff);
+    __m256i factor = _mm256_or_si256(_mm256_and_si256(alpha, rgbMask), alphaLane);
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(value, factor), bias);
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+// unpack / pack 모두 128bit lane 단위라서 픽셀 순서가 그대로 유지된다
+IMAGE_OPS_AVX2_TARGET
+static void PremultiplyRgbaAvx2(uint8_t* data, size_t pixelCount) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= pixelCount; i += 8) {
+        __m256i value = _mm256_loadu_si256((const __m256i*)(data + i * 4));
+        __m256i lo = PremultiplyAvx2(_mm256_unpacklo_epi8(value, zero));
+        __m256i hi = PremultiplyAvx2(_mm256_unpackhi_epi8(value, zero));
+        _mm256_storeu_si256((__m256i*)(data + i * 4), _mm256_packus_epi16(lo, hi));
+    }
+    PremultiplyScalar(data + i * 4, pixelCount - i, 4);
+}
+#endif
+
+void PremultiplyAlpha(Image* image, Kernel kernel) {
+    PROFILE_SCOPE("ImageOps::PremultiplyAlpha");
+    int channelCount = image->GetChannelCount();
+    // alpha가 있는 포맷(gray + alpha, RGBA)만
+    if (channelCount != 2 && channelCount != 4)
+        return;
+    uint8_t* data = image->GetData();
+    size_t pixelCount = GetPixelCount(image);
+    switch (channelCount == 4 ? ResolveKernel(kernel) : Kernel::Scalar) {
+#ifdef IMAGE_OPS_USE_AVX2
+    case Kernel::Avx2: PremultiplyRgbaAvx2(data, pixelCount); break;
+#endif
+#ifdef IMAGE_OPS_USE_SSE
+    case Kernel::Sse2: PremultiplyRgbaSse2(data, pixelCount); break;
+#endif
+    default: PremultiplyScalar(data, pixelCount, channelCount); break;
+    }
+}
+
+/*
+    sRGB <-> linear
+    8bit 입력은 256가지 뿐이므로 table 변환이 정확하고 가장 빠르다
+    SSE2에는 gather가 없고 AVX2 gather는 L1에 있는 table의 scalar 조회보다 느려서 SIMD 경로를 두지 않는다
+*/
+struct SrgbTables {
+    uint8_t toLinear[256];
+    uint8_t toSrgb[256];
+};
+
+static SrgbTables BuildSrgbTables() {
+    SrgbTables tables;
+    for (int i = 0; i < 256; i++) {
+        double c = i / 255.0;
+        double linear = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+        double srgb = c <= 0.0031308 ? c * 12.92 : 1.055 * std::pow(c, 1.0 / 2.4) - 0.055;
+        tables.toLinear[i] = (uint8_t)std::lround(linear * 255.0);
+        tables.toSrgb[i] = (uint8_t)std::lround(srgb * 255.0);
+    }
+    return tables;
+}
+
+static const SrgbTables& GetSrgbTables() {
+    static const SrgbTables tables = BuildSrgbTables();
+    return tables;
+}
+
+static void ApplyTable(Image* image, const uint8_t* table) {
+    int channelCount = image->GetChannelCount();
+    // alpha는 선형 값이므로 변환하지 않는다
+    int colorCount = (channelCount == 2 || channelCount == 4) ? channelCount - 1 : channelCount;
+    uint8_t* data = image->GetData();
+    size_t pixelCount = GetPixelCount(image);
+    for (size_t i = 0; i < pixelCount; i++) {
+        uint8_t* p = data + i * channelCount;
+        for (int k = 0; k < colorCount; k++)
+            p[k] = table[p[k]];
+    }
+}
+
+void SrgbToLinear(Image* image) {
+    PROFILE_SCOPE("ImageOps::SrgbToLinear");
+    ApplyTable(image, GetSrgbTables().toLinear);
+}
+
+void LinearToSrgb(Image* image) {
+    PROFILE_SCOPE("ImageOps::LinearToSrgb");
+    ApplyTable(image, GetSrgbTables().toSrgb);
+}
+
+/*
+    상하 반전: 위 아래 행을 맞바꾼다
+*/
+static void SwapScalar(uint8_t* a, uint8_t* b, size_t size) {
+    for (size_t i = 0; i < size; i++)
+        std::swap(a[i], b[i]);
+}
+
+#ifdef IMAGE_OPS_USE_SSE
+static void SwapSse2(uint8_t* a, uint8_t* b, size_t size) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        _mm_storeu_si128((__m128i*)(a + i), vb);
+        _mm_storeu_si128((__m128i*)(b + i), va);
+    }
+    SwapScalar(a + i, b + i, size - i);
+}
+#endif
+
+#ifdef IMAGE_OPS_USE_AVX2
+IMAGE_OPS_AVX2_TARGET
+static void SwapAvx2(uint8_t* a, uint8_t* b, size_t size) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(a + i), vb);
+        _mm256_storeu_si256((__m256i*)(b + i), va);
+    }
+    SwapScalar(a + i, b + i, size - i);
+}
+#endif
+
+void FlipVertical(Image* image, Kernel kernel) {
+    PROFILE_SCOPE("ImageOps::FlipVertical");
+    void (*swapRow)(uint8_t*, uint8_t*, size_t) = SwapScalar;
+    switch (ResolveKernel(kernel)) {
+#ifdef IMAGE_OPS_USE_AVX2
+    case Kernel::Avx2: swapRow = SwapAvx2; break;
+#endif
+#ifdef IMAGE_OPS_USE_SSE
+    case Kernel::Sse2: swapRow = SwapSse2; break;
+#endif
+    default: break;
+    }
+    size_t stride = (size_t)image->GetWidth() * image->GetChannelCount();
+    uint8_t* data = image->GetData();
+    int height = image->GetHeight();
+    for (int j = 0; j < height / 2; j++)
+        swapRow(data + j * stride, data + (height - 1 - j) * stride, stride);
+}
+
+/*
+    box downsample: (2x2 합 + 2) / 4
+    SIMD 경로는 2행이 모두 있고 2x2 블록이 원본 안에 들어오는 부분만 처리하고
+    홀수 크기 / 1픽셀 크기의 가장자리는 scalar로 처리한다
+*/
+static void BoxPixel(const Image* image, uint8_t* dst, int i, int j) {
+    int width = image->GetWidth();
+    int height = image->GetHeight();
+    int channelCount = image->GetChannelCount();
+    const uint8_t* src = image->GetData();
+    // 홀수 크기나 1픽셀 크기에서도 원본 범위를 벗어나지 않게
+    int y0 = std::min(j * 2, height - 1);
+    int y1 = std::min(j * 2 + 1, height - 1);
+    int x0 = std::min(i * 2, width - 1);
+    int x1 = std::min(i * 2 + 1, width - 1);
+    for (int k = 0; k < channelCount; k++) {
+        int sum = src[((size_t)y0 * width + x0) * channelCount + k] +
+            src[((size_t)y0 * width + x1) * channelCount + k] +
+            src[((size_t)y1 * width + x0) * channelCount + k] +
+            src[((size_t)y1 * width + x1) * channelCount + k];
+        dst[k] = (uint8_t)((sum + 2) / 4);
+    }
+}
+
+// 한 행에서 SIMD로 처리한 출력 픽셀 수를 반환
+using BoxRowFunc = int (*)(const uint8_t*, const uint8_t*, uint8_t*, int);
+
+#ifdef IMAGE_OPS_USE_SSE
+// 16bit로 확장한 두 행을 더한 뒤 이웃한 픽셀끼리 더한다
+static int BoxRowSse2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int width) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(2);
+    int i = 0;
+    for (; i + 2 <= width; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(row0 + i * 8));
+        __m128i b = _mm_loadu_si128((const __m128i*)(row1 + i * 8));
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, bias), 2);
+        _mm_storel_epi64((__m128i*)(dst + i * 4), _mm_packus_epi16(sum, sum));
+    }
+    return i;
+}
+#endif
+
+#ifdef IMAGE_OPS_USE_AVX2
+IMAGE_OPS_AVX2_TARGET
+static int BoxRowAvx2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst, int width) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bias = _mm256_set1_epi16(2);
+    int i = 0;
+    for (; i + 4 <= width; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(row0 + i * 8));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(row1 + i * 8));
+        __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+        __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+        __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+        sum = _mm256_srli_epi16(_mm256_add_epi16(sum, bias), 2);
+        // lane 마다 앞 8byte가 결과. 두 lane의 결과를 모은다
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+#endif
+
+static ImageUPtr DownsampleBox(const Image* image, Kernel kernel) {
+    int width = std::max(image->GetWidth() / 2, 1);
+    int height = std::max(image->GetHeight() / 2, 1);
+    int channelCount = image->GetChannelCount();
+    auto result = Image::Create(width, height, channelCount);
+    if (!result)
+        return nullptr;
+
+    BoxRowFunc boxRow = nullptr;
+    if (channelCount == 4 && image->GetWidth() >= 2 && image->GetHeight() >= 2) {
+        switch (ResolveKernel(kernel)) {
+#ifdef IMAGE_OPS_USE_AVX2
+        case Kernel::Avx2: boxRow = BoxRowAvx2; break;
+#endif
+#ifdef IMAGE_OPS_USE_SSE
+        case Kernel::Sse2: boxRow = BoxRowSse2; break;
+#endif
+        default: break;
+        }
+    }
+
+    size_t srcStride = (size_t)image->GetWidth() * channelCount;
+    size_t dstStride = (size_t)width * channelCount;
+    for (int j = 0; j < height; j++) {
+        uint8_t* dst = result->GetData() + j * dstStride;
+        int i = 0;
+        if (boxRow) {
+            const uint8_t* row0 = image->GetData() + (size_t)j * 2 * srcStride;
+            i = boxRow(row0, row0 + srcStride, dst, width);
+        }
+        for (; i < width; i++)
+            BoxPixel(image, dst + i * channelCount, i, j);
+    }
+    return std::move(result);
+}
+
+/*
+    Kaiser downsample
+    출력 픽셀 중심에서 원본 4픽셀 범위(출력 기준 2픽셀)까지 8 tap, 가로 -> 세로 순서로 separable
+    중간 결과는 float. SSE2는 RGBA 한 픽셀, AVX2는 두 픽셀을 한 vector로 처리하고 tap 순서가 같으므로
+    scalar와 곱셈 / 덧셈 순서가 동일해서 결과가 같다
+*/
+static constexpr int kKaiserTapCount = 8;
+
+static double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+static std::array<float, kKaiserTapCount> BuildKaiserWeights() {
+    const double radius = 2.0;
+    const double beta = 4.0;
+    const double pi = 3.14159265358979323846;
+    std::array<double, kKaiserTapCount> weights;
+    double total = 0.0;
+    for (int t = 0; t < kKaiserTapCount; t++) {
+        // 원본 픽셀 중심과 출력 픽셀 중심 사이의 거리 (출력 픽셀 단위)
+        double d = (t - 3.5) / 2.0;
+        double sinc = std::sin(pi * d) / (pi * d);
+        double r = d / radius;
+        double window = BesselI0(beta * std::sqrt(std::max(1.0 - r * r, 0.0))) / BesselI0(beta);
+        weights[t] = sinc * window;
+        total += weights[t];
+    }
+    std::array<float, kKaiserTapCount> result;
+    for (int t = 0; t < kKaiserTapCount; t++)
+        result[t] = (float)(weights[t] / total);
+    return result;
+}
+
+static const std::array<float, kKaiserTapCount>& GetKaiserWeights() {
+    static const std::array<float, kKaiserTapCount> weights = BuildKaiserWeights();
+    return weights;
+}
+
+static uint8_t ToByte(float value) {
+    value = std::min(std::max(value, 0.0f), 255.0f);
+    return (uint8_t)(int)(value + 0.5f);
+}
+
+// 출력 i번째 픽셀의 t번째 tap이 가리키는 원본 좌표
+static int KaiserSource(int i, int t, int size) {
+    return std::min(std::max(i * 2 - 3 + t, 0), size - 1);
+}
+
+static void KaiserScalar(const Image* image, float* temp, Image* result) {
+    const auto& weights = GetKaiserWeights();
+    int srcWidth = image->GetWidth();
+    int srcHeight = image->GetHeight();
+    int width = result->GetWidth();
+    int height = result->GetHeight();
+    int channelCount = image->GetChannelCount();
+    const uint8_t* src = image->GetData();
+    uint8_t* dst = result->GetData();
+
+    for (int y = 0; y < srcHeight; y++) {
+        for (int i = 0; i < width; i++) {
+            for (int k = 0; k < channelCount; k++) {
+                float sum = 0.0f;
+                for (int t = 0; t < kKaiserTapCount; t++) {
+                    int x = KaiserSource(i, t, srcWidth);
+                    sum += weights[t] * (float)src[((size_t)y * srcWidth + x) * channelCount + k];
+                }
+                temp[((size_t)y * width + i) * channelCount + k] = sum;
+            }
+        }
+    }
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            for (int k = 0; k < channelCount; k++) {
+                float sum = 0.0f;
+                for (int t = 0; t < kKaiserTapCount; t++) {
+                    int y = KaiserSource(j, t, srcHeight);
+                    sum += weights[t] * temp[((size_t)y * width + i) * channelCount + k];
+                }
+                dst[((size_t)j * width + i) * channelCount + k] = ToByte(sum);
+            }
+        }
+    }
+}
+
+#ifdef IMAGE_OPS_USE_SSE
+// 가로 방향: 출력 i번째 픽셀의 RGBA 4채널
+static __m128 KaiserPixelSse2(const uint8_t* row, int i, int srcWidth, const float* weights) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128 sum = _mm_setzero_ps();
+    for (int t = 0; t < kKaiserTapCount; t++) {
+        __m128i pixel = _mm_cvtsi32_si128((int)LoadPixel(row + KaiserSource(i, t, srcWidth) * 4));
+        pixel = _mm_unpacklo_epi16(_mm_unpacklo_epi8(pixel, zero), zero);
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_cvtepi32_ps(pixel)));
+    }
+    return sum;
+}
+
+// 세로 방향: 가로 결과 rows[t]의 offset 위치 float 4개를 합쳐 byte 4개로 기록
+static void KaiserColumnSse2(const float* const* rows, size_t offset, const float* weights, uint8_t* dst) {
+    __m128 sum = _mm_setzero_ps();
+    for (int t = 0; t < kKaiserTapCount; t++)
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(rows[t] + offset)));
+    sum = _mm_min_ps(_mm_max_ps(sum, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    __m128i pixel = _mm_cvttps_epi32(_mm_add_ps(sum, _mm_set1_ps(0.5f)));
+    pixel = _mm_packus_epi16(_mm_packs_epi32(pixel, pixel), _mm_setzero_si128());
+    uint32_t value = (uint32_t)_mm_cvtsi128_si32(pixel);
+    memcpy(dst, &value, 4);
+}
+
+static void KaiserRgbaSse2(const Image* image, float* temp, Image* result) {
+    const float* weights = GetKaiserWeights().data();
+    int srcWidth = image->GetWidth();
+    int srcHeight = image->GetHeight();
+    int width = result->GetWidth();
+    int height = result->GetHeight();
+    const uint8_t* src = image->GetData();
+    uint8_t* dst = result->GetData();
+
+    for (int y = 0; y < srcHeight; y++) {
+        const uint8_t* row = src + (size_t)y * srcWidth * 4;
+        for (int i = 0; i < width; i++)
+            _mm_storeu_ps(temp + ((size_t)y * width + i) * 4, KaiserPixelSse2(row, i, srcWidth, weights));
+    }
+
+    size_t rowSize = (size_t)width * 4;
+    const float* rows[kKaiserTapCount];
+    for (int j = 0; j < height; j++) {
+        for (int t = 0; t < kKaiserTapCount; t++)
+            rows[t] = temp + KaiserSource(j, t, srcHeight) * rowSize;
+        for (size_t x = 0; x < rowSize; x += 4)
+            KaiserColumnSse2(rows, x, weights, dst + j * rowSize + x);
+    }
+}
+#endif
+
+#ifdef IMAGE_OPS_USE_AVX2
+// 한 vector에 RGBA 두 픽셀. 각 lane의 곱셈 / 덧셈 순서는 scalar와 같다 (FMA를 사용하지 않음)
+IMAGE_OPS_AVX2_TARGET
+static void KaiserRgbaAvx2(const Image* image, float* temp, Image* result) {
+    const float* weights = GetKaiserWeights().data();
+    int srcWidth = image->GetWidth();
+    int srcHeight = image->GetHeight();
+    int width = result->GetWidth();
+    int height = result->GetHeight();
+    const uint8_t* src = image->GetData();
+    uint8_t* dst = result->GetData();
+
+    for (int y = 0; y < srcHeight; y++) {
+        const uint8_t* row = src + (size_t)y * srcWidth * 4;
+        float* out = temp + (size_t)y * width * 4;
+        int i = 0;
+        for (; i + 1 < width; i += 2) {
+            __m256 sum = _mm256_setzero_ps();
+            for (int t = 0; t < kKaiserTapCount; t++) {
+                __m128i pair = _mm_unpacklo_epi32(
+                    _mm_cvtsi32_si128((int)LoadPixel(row + KaiserSource(i, t, srcWidth) * 4)),
+                    _mm_cvtsi32_si128((int)LoadPixel(row + KaiserSource(i + 1, t, srcWidth) * 4)));
+                __m256 value = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(pair));
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[t]), value));
+            }
+            _mm256_storeu_ps(out + i * 4, sum);
+        }
+        // 홀수 너비의 마지막 픽셀
+        for (; i < width; i++)
+            _mm_storeu_ps(out + i * 4, KaiserPixelSse2(row, i, srcWidth, weights));
+    }
+
+    size_t rowSize = (size_t)width * 4;
+    const float* rows[kKaiserTapCount];
+    const __m256 minValue = _mm256_setzero_ps();
+    const __m256 maxValue = _mm256_set1_ps(255.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    for (int j = 0; j < height; j++) {
+        for (int t = 0; t < kKaiserTapCount; t++)
+            rows[t] = temp + KaiserSource(j, t, srcHeight) * rowSize;
+        uint8_t* out = dst + j * rowSize;
+        size_t x = 0;
+        for (; x + 8 <= rowSize; x += 8) {
+            __m256 sum = _mm256_setzero_ps();
+            for (int t = 0; t < kKaiserTapCount; t++)
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[t]), _mm256_loadu_ps(rows[t] + x)));
+            sum = _mm256_min_ps(_mm256_max_ps(sum, minValue), maxValue);
+            __m256i value = _mm256_cvttps_epi32(_mm256_add_ps(sum, half));
+            // 128bit lane 단위로 pack되므로 두 lane을 나누어 묶는다
+            __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+            _mm_storel_epi64((__m128i*)(out + x), _mm_packus_epi16(packed, _mm_setzero_si128()));
+        }
+        for (; x < rowSize; x += 4)
+            KaiserColumnSse2(rows, x, weights, out + x);
+    }
+}
+#endif
+
+static ImageUPtr DownsampleKaiser(const Image* image, Kernel kernel) {
+    int width = std::max(image->GetWidth() / 2, 1);
+    int height = std::max(image->GetHeight() / 2, 1);
+    int channelCount = image->GetChannelCount();
+    auto result = Image::Create(width, height, channelCount);
+    if (!result)
+        return nullptr;
+
+    // 가로 방향 결과 (출력 너비 x 원본 높이)
+    std::vector<float> temp((size_t)width * image->GetHeight() * channelCount);
+    switch (channelCount == 4 ? ResolveKernel(kernel) : Kernel::Scalar) {
+#ifdef IMAGE_OPS_USE_AVX2
+    case Kernel::Avx2: KaiserRgbaAvx2(image, temp.data(), result.get()); break;
+#endif
+#ifdef IMAGE_OPS_USE_SSE
+    case Kernel::Sse2: KaiserRgbaSse2(image, temp.data(), result.get()); break;
+#endif
+    default: KaiserScalar(image, temp.data(), result.get()); break;
+    }
+    return std::move(result);
+}
+
+ImageUPtr Downsample(const Image* image, MipFilter filter, Kernel kernel) {
+    PROFILE_SCOPE("ImageOps::Downsample");
+    if (filter == MipFilter::Kaiser)
+        return DownsampleKaiser(image, kernel);
+    return DownsampleBox(image, kernel);
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef __IMAGE_OPS_H__
+#define __IMAGE_OPS_H__
+
+#include "image.h"
+
+/*
+    CPU 이미지 처리 kernel. 모두 GL을 사용하지 않으므로 worker thread에서 호출할 수 있다
+    각 연산은 scalar 기준 구현과 SSE2 / AVX2 구현을 가지며, 결과는 scalar와 bit 단위로 같다
+    - SSE2는 x86-64 기본 명령이므로 컴파일 시점에 결정
+    - AVX2는 함수 단위 target 지정으로 컴파일하고 실행 시점에 CPU 지원 여부를 확인
+    지원하지 않는 kernel을 요청하면 한 단계 낮은 kernel을 사용한다
+    SIMD 경로는 RGBA(4채널) 이미지에 대해서만 동작하고, 그 외 채널 수는 scalar로 처리
+    sRGB 변환은 table 조회라서 kernel 구분 없이 scalar 하나만 있다
+*/
+namespace ImageOps {
+
+enum class Kernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+enum class MipFilter {
+    Box,    // 2x2 평균. Image::Downsample과 같은 결과
+    Kaiser, // Kaiser window를 씌운 sinc (8 tap, separable). 고주파 aliasing이 적다
+};
+
+bool IsKernelSupported(Kernel kernel);
+// 요청한 kernel을 지원하지 않으면 지원하는 가장 높은 kernel
+Kernel ResolveKernel(Kernel kernel);
+const char* GetKernelName(Kernel kernel);
+
+// color는 채널 수만큼의 값
+void FillSolid(Image* image, const uint8_t* color, Kernel kernel = Kernel::Avx2);
+// grid 크기의 흰색 / 검은색 체크 무늬. alpha 채널은 255
+void FillChecker(Image* image, int gridX, int gridY, Kernel kernel = Kernel::Avx2);
+
+// 1 / 2 / 3 채널 이미지를 RGBA로 확장 (gray는 RGB에 복제, alpha가 없으면 255)
+// 업로드 포맷이 항상 GL_RGBA가 되고 4byte 행 정렬 문제도 없어진다
+ImageUPtr ExpandToRgba(const Image* image, Kernel kernel = Kernel::Avx2);
+// RGB에 alpha를 곱한다. round(c * a / 255)
+void PremultiplyAlpha(Image* image, Kernel kernel = Kernel::Avx2);
+// 8bit 값 변환 (256개 table). alpha 채널은 그대로
+void SrgbToLinear(Image* image);
+void LinearToSrgb(Image* image);
+void FlipVertical(Image* image, Kernel kernel = Kernel::Avx2);
+// 가로 세로 절반 크기 (최소 1)의 다음 mip 레벨
+ImageUPtr Downsample(const Image* image, MipFilter filter = MipFilter::Box,
+    Kernel kernel = Kernel::Avx2);
+
+}
+
+#endif // __IMAGE_OPS_H__
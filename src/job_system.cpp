@@ -0,0 +1,119 @@
+#include "job_system.h"
+
+JobSystemUPtr JobSystem::Create(size_t workerCount) {
+    auto jobSystem = JobSystemUPtr(new JobSystem());
+    jobSystem->Init(workerCount);
+    return std::move(jobSystem);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void JobSystem::Init(size_t workerCount) {
+    if (workerCount == 0)
+        workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    m_queues.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++)
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++)
+        m_workers.emplace_back([this, i]() { WorkerLoop(i); });
+    SPDLOG_INFO("job system: {} workers", workerCount);
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const RangeFunction& function) {
+    if (count == 0)
+        return;
+    grainSize = std::max<size_t>(grainSize, 1);
+    size_t jobCount = (count + grainSize - 1) / grainSize;
+    if (jobCount == 1 || m_workers.empty()) {
+        function(0, count);
+        return;
+    }
+
+    // worker마다 연속된 구간을 맡겨 캐시 지역성을 유지한다
+    std::atomic<size_t> remaining { jobCount };
+    size_t queueCount = m_queues.size();
+    for (size_t q = 0; q < queueCount; q++) {
+        size_t firstJob = jobCount * q / queueCount;
+        size_t lastJob = jobCount * (q + 1) / queueCount;
+        if (firstJob == lastJob)
+            continue;
+        std::lock_guard<std::mutex> lock(m_queues[q]->mutex);
+        for (size_t j = firstJob; j < lastJob; j++) {
+            Job job;
+            job.function = &function;
+            job.begin = j * grainSize;
+            job.end = std::min(count, job.begin + grainSize);
+            job.remaining = &remaining;
+            m_queues[q]->jobs.push_back(job);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_queuedCount += jobCount;
+    }
+    m_wakeCondition.notify_all();
+
+    // 호출한 thread도 남은 job을 훔쳐서 처리
+    Job job;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (StealJob(0, job))
+            Execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::WorkerLoop(size_t index) {
+    Job job;
+    while (true) {
+        if (PopJob(index, job) || StealJob(index + 1, job)) {
+            Execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [this]() { return m_stop || m_queuedCount > 0; });
+        if (m_stop)
+            return;
+    }
+}
+
+bool JobSystem::PopJob(size_t index, Job& job) {
+    auto& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+    // 자기 큐는 뒤에서 꺼낸다 (다른 thread는 앞에서 훔쳐가므로 충돌이 적다)
+    job = queue.jobs.back();
+    queue.jobs.pop_back();
+    m_queuedCount--;
+    return true;
+}
+
+bool JobSystem::StealJob(size_t start, Job& job) {
+    size_t queueCount = m_queues.size();
+    for (size_t i = 0; i < queueCount; i++) {
+        auto& queue = *m_queues[(start + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+        m_queuedCount--;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(const Job& job) {
+    (*job.function)(job.begin, job.end);
+    job.remaining->fetch_sub(1, std::memory_order_release);
+}
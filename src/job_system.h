@@ -0,0 +1,66 @@
+#ifndef __JOB_SYSTEM_H__
+#define __JOB_SYSTEM_H__
+
+#include "common.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    parallel-for 전용 work-stealing job system
+    범위를 grain 크기의 job으로 나누어 worker마다 연속된 구간씩 큐에 넣고,
+    각 worker는 자기 큐의 뒤에서 꺼내고 할 일이 없으면 다른 큐의 앞에서 훔쳐온다.
+    ParallelFor를 호출한 thread도 끝날 때까지 job을 처리하므로
+    worker는 (코어 수 - 1)개만 만든다.
+
+    ThreadPool과 달리 future / 동적할당 없이 프레임마다 반복되는
+    짧은 데이터 병렬 작업(transform 갱신 등)을 위한 것
+*/
+CLASS_PTR(JobSystem)
+class JobSystem {
+public:
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    // workerCount가 0이면 (하드웨어 스레드 개수 - 1)개 생성
+    static JobSystemUPtr Create(size_t workerCount = 0);
+    ~JobSystem();
+
+    size_t GetWorkerCount() const { return m_workers.size(); }
+
+    // [0, count)를 grainSize 단위로 나누어 병렬로 function(begin, end)를 호출하고
+    // 모두 끝나면 반환한다. job이 하나뿐이면 호출한 thread에서 바로 실행
+    void ParallelFor(size_t count, size_t grainSize, const RangeFunction& function);
+
+private:
+    struct Job {
+        const RangeFunction* function { nullptr };
+        size_t begin { 0 };
+        size_t end { 0 };
+        std::atomic<size_t>* remaining { nullptr };
+    };
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    JobSystem() {}
+    void Init(size_t workerCount);
+    void WorkerLoop(size_t index);
+    bool PopJob(size_t index, Job& job);
+    bool StealJob(size_t start, Job& job);
+    void Execute(const Job& job);
+
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    // 큐에 남아있는 job 개수. 증가는 m_wakeMutex 안에서만 한다
+    std::atomic<size_t> m_queuedCount { 0 };
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_stop { false };
+};
+
+#endif // __JOB_SYSTEM_H__
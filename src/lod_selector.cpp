@@ -0,0 +1,45 @@
+#include "lod_selector.h"
+#include <algorithm>
+
+static constexpr uint8_t kNoLod = 0xff;
+
+LodSelectorUPtr LodSelector::Create(const std::vector<float>& thresholds, float hysteresis) {
+    auto selector = LodSelectorUPtr(new LodSelector());
+    selector->m_thresholds = thresholds;
+    selector->m_hysteresis = hysteresis;
+    return std::move(selector);
+}
+
+float LodSelector::ComputeScreenSize(const glm::vec3& center, float radius,
+    const glm::mat4& view, const glm::mat4& projection) {
+    // 카메라가 bounding sphere 안에 있으면 화면을 가득 채운 것으로 본다
+    float distance = -(view * glm::vec4(center, 1.0f)).z;
+    if (distance <= radius)
+        return 1.0f;
+    // projection[1][1] = 1 / tan(fovy / 2). NDC 높이가 2이므로 지름 / 높이 = radius * p11 / distance
+    return radius * projection[1][1] / distance;
+}
+
+uint32_t LodSelector::FindLod(float screenSize, float scale, uint32_t lodCount) const {
+    uint32_t lod = 0;
+    while (lod + 1 < lodCount && lod < m_thresholds.size() &&
+        screenSize < m_thresholds[lod] * scale)
+        lod++;
+    return lod;
+}
+
+uint32_t LodSelector::Select(uint32_t objectIndex, float screenSize, uint32_t lodCount) {
+    if (objectIndex >= m_currentLods.size())
+        m_currentLods.resize(objectIndex + 1, kNoLod);
+    uint8_t& current = m_currentLods[objectIndex];
+    if (m_hysteresis <= 0.0f || current == kNoLod) {
+        current = (uint8_t)FindLod(screenSize, 1.0f, lodCount);
+        return current;
+    }
+    // 거친 LOD로는 threshold보다 충분히 작아져야, 세밀한 LOD로는 충분히 커져야 바꾼다
+    uint32_t finest = FindLod(screenSize, 1.0f - m_hysteresis, lodCount);
+    uint32_t coarsest = FindLod(screenSize, 1.0f + m_hysteresis, lodCount);
+    uint32_t lod = std::min<uint32_t>(current, lodCount - 1);
+    current = (uint8_t)std::min(std::max(lod, finest), coarsest);
+    return current;
+}
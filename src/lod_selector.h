@@ -0,0 +1,40 @@
+#ifndef __LOD_SELECTOR_H__
+#define __LOD_SELECTOR_H__
+
+#include "common.h"
+#include <vector>
+
+/*
+    화면에서 차지하는 크기에 따라 물체별 LOD를 고른다
+    screen size: bounding sphere의 지름이 화면 높이에서 차지하는 비율
+    screen size가 thresholds[i] 미만이면 LOD i + 1 이상을 사용 (thresholds는 내림차순)
+
+    hysteresis: threshold 주변에서 LOD가 프레임마다 바뀌는 popping을 막기 위한 비율
+    threshold * (1 - hysteresis) ~ threshold * (1 + hysteresis) 구간 안에서는
+    물체가 직전에 쓰던 LOD를 유지한다. 0이면 사용하지 않음
+*/
+CLASS_PTR(LodSelector)
+class LodSelector {
+public:
+    static LodSelectorUPtr Create(const std::vector<float>& thresholds = { 0.25f, 0.12f, 0.06f },
+        float hysteresis = 0.1f);
+
+    static float ComputeScreenSize(const glm::vec3& center, float radius,
+        const glm::mat4& view, const glm::mat4& projection);
+
+    void SetHysteresis(float hysteresis) { m_hysteresis = hysteresis; }
+    float GetHysteresis() const { return m_hysteresis; }
+
+    // objectIndex별로 직전 LOD를 기억한다. lodCount: 메쉬가 가진 LOD 수
+    uint32_t Select(uint32_t objectIndex, float screenSize, uint32_t lodCount);
+
+private:
+    LodSelector() {}
+    uint32_t FindLod(float screenSize, float scale, uint32_t lodCount) const;
+
+    std::vector<float> m_thresholds;
+    float m_hysteresis { 0.0f };
+    std::vector<uint8_t> m_currentLods;
+};
+
+#endif // __LOD_SELECTOR_H__
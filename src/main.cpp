@@ -1,8 +1,27 @@
 #include "context.h"
+#include "profiler.h"
+#include "framebuffer.h"
+#include "frame_reader.h"
+#include "culling.h"
+#include "scene.h"
+#include "mesh.h"
+#include "shader_library.h"
+#include "texture_atlas.h"
+#include "image_ops.h"
+#include "render_state.h"
 
 #include <spdlog/spdlog.h>
 #include <glad/glad.h> // 반드시 GLFW 라이브러리 이전에 추가할 것
 #include <GLFW/glfw3.h>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <thread>
 
 // #define WINDOW_NAME "Hello, OpenGL"
 // #define WINDOW_WIDTH 960
@@ -27,6 +46,18 @@ void OnKeyEvent(GLFWwindow* window,
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
         glfwSetWindowShouldClose(window, true);
     }
+    // P 키로 최근 프레임의 프로파일 기록 저장
+    if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+        auto& profiler = Profiler::Get();
+        if (profiler.SaveJson("./profile.json") && profiler.SaveChromeTrace("./profile_trace.json"))
+            SPDLOG_INFO("profile saved: {} frames", profiler.GetHistory().size());
+    }
+    // I 키로 instanced rendering on / off
+    if (key == GLFW_KEY_I && action == GLFW_PRESS) {
+        auto context = reinterpret_cast<Context*>(glfwGetWindowUserPointer(window));
+        context->SetInstancing(!context->IsInstancing());
+        SPDLOG_INFO("instancing: {}", context->IsInstancing() ? "on" : "off");
+    }
 }
 
 void OnCursorPos(GLFWwindow* window, double x, double y) {
@@ -41,9 +72,865 @@ void OnMouseButton(GLFWwindow* window, int button, int action, int modifier) {
     context->MouseButton(button, action, x, y);
 }
 
+// 실행 인자
+// --headless: 창을 띄우지 않고 오프스크린으로 렌더링하여 프레임을 파일로 저장
+// --frames N: headless 모드에서 렌더링할 프레임 수
+// --output DIR: 저장할 디렉토리
+// --cull-benchmark N: N개의 물체로 frustum culling 성능을 측정하고 종료 (창 생성 없음)
+// --scene-benchmark N: N개 노드의 scene graph 갱신 성능을 측정하고 종료 (창 생성 없음)
+// --queue-benchmark N: draw command N개의 submit / 정렬 시간을 radix sort와 std::sort로 비교하고 종료 (창 생성 없음)
+// --mesh-benchmark FILE: OBJ 메쉬 최적화 전후의 vertex cache 효율(ACMR / ATVR), overdraw, 처리 속도를 측정하고 종료 (창 생성 없음)
+// --cook-mesh IN OUT: OBJ 메쉬를 최적화 / 양자화된 .mesh 파일로 변환하고 종료 (창 생성 없음)
+// --shader-benchmark N: N개의 program permutation을 순차 / 일괄 컴파일하는 시간을 측정하고 종료
+// --atlas-benchmark N: 무작위 크기의 이미지 N개를 atlas에 배치하는 시간과 효율을 측정하고 종료 (창 생성 없음)
+// --draw-benchmark N: N개의 큐브를 물체별 draw / instanced draw로 그려 draw call / 상태 변경 수와 프레임 시간을 측정하고 종료
+//   material 텍스처를 따로 두는 경우와 atlas / texture array에 모으는 경우를 각각 측정
+// --materials M: draw benchmark에서 큐브에 번갈아 사용할 material 수 (기본 64)
+// --startup-benchmark N: 이미지 N개의 순차 / 병렬 로딩 시간과 program N개의 cold / warm 로딩 시간을 측정하고 종료
+// --image-benchmark N: 약 N x N 이미지로 ImageOps kernel별 처리량을 측정하고 scalar 결과와 비교한 뒤 종료 (창 생성 없음)
+// --image-test: ImageOps SIMD kernel 결과를 여러 크기 / 채널 수에서 scalar와 비교. 다르면 0이 아닌 값으로 종료 (창 생성 없음)
+struct Options {
+    bool headless { false };
+    int frameCount { 60 };
+    std::string outputDirectory { "./output" };
+    int cullBenchmarkCount { 0 };
+    int sceneBenchmarkCount { 0 };
+    int queueBenchmarkCount { 0 };
+    std::string meshBenchmarkFile;
+    std::string cookMeshInput;
+    std::string cookMeshOutput;
+    int shaderBenchmarkCount { 0 };
+    int atlasBenchmarkCount { 0 };
+    int imageBenchmarkSize { 0 };
+    bool imageTest { false };
+    int drawBenchmarkCount { 0 };
+    int materialCount { 64 };
+    int startupBenchmarkCount { 0 };
+};
+
+bool ParseOptions(int argc, const char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            options.headless = true;
+        }
+        else if (arg == "--frames" && i + 1 < argc) {
+            options.frameCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            options.outputDirectory = argv[++i];
+        }
+        else if (arg == "--cull-benchmark" && i + 1 < argc) {
+            options.cullBenchmarkCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--scene-benchmark" && i + 1 < argc) {
+            options.sceneBenchmarkCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--queue-benchmark" && i + 1 < argc) {
+            options.queueBenchmarkCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--mesh-benchmark" && i + 1 < argc) {
+            options.meshBenchmarkFile = argv[++i];
+        }
+        else if (arg == "--cook-mesh" && i + 2 < argc) {
+            options.cookMeshInput = argv[++i];
+            options.cookMeshOutput = argv[++i];
+        }
+        else if (arg == "--shader-benchmark" && i + 1 < argc) {
+            options.shaderBenchmarkCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--atlas-benchmark" && i + 1 < argc) {
+            options.atlasBenchmarkCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--draw-benchmark" && i + 1 < argc) {
+            options.drawBenchmarkCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--materials" && i + 1 < argc) {
+            options.materialCount = std::max(std::atoi(argv[++i]), 1);
+        }
+        else if (arg == "--startup-benchmark" && i + 1 < argc) {
+            options.startupBenchmarkCount = std::atoi(argv[++i]);
+        }
+        else if (arg == "--image-benchmark" && i + 1 < argc) {
+            options.imageBenchmarkSize = std::atoi(argv[++i]);
+        }
+        else if (arg == "--image-test") {
+            options.imageTest = true;
+        }
+        else {
+            SPDLOG_ERROR("unknown argument: {}", arg);
+            SPDLOG_ERROR("usage: {} [--headless] [--frames N] [--output DIR] [--cull-benchmark N] [--scene-benchmark N] [--queue-benchmark N] [--mesh-benchmark FILE] [--cook-mesh IN OUT] [--shader-benchmark N] [--atlas-benchmark N] [--image-benchmark N] [--image-test] [--draw-benchmark N] [--materials M] [--startup-benchmark N]", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int RunHeadless(Context* context, const Options& options) {
+    auto framebuffer = Framebuffer::Create(WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!framebuffer)
+        return -1;
+    auto reader = FrameReader::Create(WINDOW_WIDTH, WINDOW_HEIGHT, options.outputDirectory);
+    if (!reader)
+        return -1;
+
+    framebuffer->Bind();
+    context->Reshape(WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    // 텍스처 로딩이 끝날 때까지는 저장하지 않는다
+    while (context->IsLoading())
+        context->Render();
+
+    SPDLOG_INFO("Render {} frames to {}", options.frameCount, options.outputDirectory);
+    auto start = glfwGetTime();
+    for (int i = 0; i < options.frameCount; i++) {
+        Profiler::Get().BeginFrame();
+        // 결과가 실행 속도에 영향받지 않도록 60fps 기준 고정 시간 사용
+        context->SetFixedTime(i / 60.0);
+        context->Render();
+        reader->Capture(i);
+        Profiler::Get().EndFrame();
+    }
+    reader->Flush();
+    SPDLOG_INFO("{} frames saved ({:.2f} s)", reader->GetSavedCount(), glfwGetTime() - start);
+    Framebuffer::BindToDefault();
+    return reader->GetSavedCount() == (size_t)options.frameCount ? 0 : -1;
+}
+
+int RunCullingBenchmark(int objectCount) {
+    // 카메라 주위에 무작위로 흩어진 물체를 scalar / SIMD 경로로 각각 컬링
+    auto culling = CullingSystem::Create(objectCount);
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+    for (int i = 0; i < objectCount; i++) {
+        float radius = size(random);
+        culling->Add(glm::vec3(position(random), position(random), position(random)),
+            glm::vec3(radius * 0.6f), radius);
+    }
+    auto projection = glm::perspective(glm::radians(45.0f),
+        (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT, 0.01f, 100.0f);
+    auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f),
+        glm::vec3(0.0f, 1.0f, 0.0f));
+    auto frustum = Frustum::FromMatrix(projection * view);
+
+    const int iterationCount = 20;
+    std::vector<uint32_t> visible[2];
+    const char* kernelNames[2] = { "scalar", "simd" };
+    CullingSystem::Kernel kernels[2] = { CullingSystem::Kernel::Scalar, CullingSystem::Kernel::Simd };
+    for (int k = 0; k < 2; k++) {
+        // 첫 실행은 캐시 / 메모리 할당 영향을 빼기 위해 측정에서 제외
+        culling->Cull(frustum, visible[k], kernels[k]);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterationCount; i++)
+            culling->Cull(frustum, visible[k], kernels[k]);
+        double elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count() / iterationCount;
+        SPDLOG_INFO("cull {}: {} objects, {} visible, {:.3f} ms ({:.0f} objects/ms)",
+            kernelNames[k], objectCount, visible[k].size(), elapsed, objectCount / elapsed);
+    }
+    if (!CullingSystem::IsSimdSupported())
+        SPDLOG_INFO("SIMD culling is not available on this target, simd uses the scalar path");
+    if (visible[0] != visible[1]) {
+        SPDLOG_ERROR("scalar and simd culling results differ");
+        return -1;
+    }
+    return 0;
+}
+
+int RunQueueBenchmark(int commandCount) {
+    /*
+        실제 프레임과 비슷한 분포의 draw command를 쌓아 Submit / Sort 시간을 측정한다
+        Sort의 radix sort와 같은 key를 std::sort로 정렬한 시간을 비교하고 순서가 같은지 확인
+    */
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+    std::vector<DrawCommand> commands(commandCount);
+    for (int i = 0; i < commandCount; i++) {
+        auto& command = commands[i];
+        command = {};
+        // program 8개, material 256개 조합에 10% 정도는 반투명
+        RenderPass pass = random() % 10 == 0 ? RenderPass::Transparent : RenderPass::Opaque;
+        command.key = RenderQueue::MakeKey(pass, 1 + random() % 8, random() % 256, depth(random));
+        command.indexCount = 36;
+    }
+
+    auto queue = RenderQueue::Create(commandCount);
+    const int iterationCount = 20;
+    double submitTime = 0.0;
+    double sortTime = 0.0;
+    for (int i = 0; i < iterationCount; i++) {
+        queue->Clear();
+        auto start = std::chrono::steady_clock::now();
+        for (auto& command : commands)
+            queue->Submit(command);
+        auto submitEnd = std::chrono::steady_clock::now();
+        queue->Sort();
+        auto sortEnd = std::chrono::steady_clock::now();
+        submitTime += std::chrono::duration<double, std::milli>(submitEnd - start).count();
+        sortTime += std::chrono::duration<double, std::milli>(sortEnd - submitEnd).count();
+    }
+
+    // 비교 대상: (key, index) 쌍을 std::sort. index까지 비교하므로 radix sort처럼 stable
+    std::vector<std::pair<uint64_t, uint32_t>> pairs(commandCount);
+    double stdSortTime = 0.0;
+    for (int i = 0; i < iterationCount; i++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int j = 0; j < commandCount; j++)
+            pairs[j] = { commands[j].key, (uint32_t)j };
+        std::sort(pairs.begin(), pairs.end());
+        stdSortTime += std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    SPDLOG_INFO("queue: {} commands, submit {:.3f} ms, radix sort {:.3f} ms, std::sort {:.3f} ms",
+        commandCount, submitTime / iterationCount, sortTime / iterationCount,
+        stdSortTime / iterationCount);
+    auto& order = queue->GetOrder();
+    for (int i = 0; i < commandCount; i++) {
+        if (order[i] != pairs[i].second) {
+            SPDLOG_ERROR("radix sort order differs from std::sort at {}", i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int RunSceneBenchmark(int nodeCount) {
+    // 4-ary tree 형태의 계층을 만들고 매 프레임 1%의 노드만 움직인다
+    auto jobSystem = JobSystem::Create();
+    auto scene = Scene::Create(jobSystem.get(), nodeCount);
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    for (int i = 0; i < nodeCount; i++) {
+        uint32_t parent = i == 0 ? Scene::kInvalidNode : (uint32_t)(i - 1) / 4;
+        scene->AddNode(parent, glm::vec3(offset(random), offset(random), offset(random)));
+    }
+    scene->Update(0.0f);
+
+    auto measure = [&](const char* name, int changeCount) {
+        const int frameCount = 100;
+        std::uniform_int_distribution<int> node(0, nodeCount - 1);
+        size_t updatedCount = 0;
+        double elapsed = 0.0;
+        for (int frame = 0; frame < frameCount; frame++) {
+            for (int i = 0; i < changeCount; i++) {
+                uint32_t changed = changeCount == nodeCount ? (uint32_t)i : (uint32_t)node(random);
+                scene->SetLocalPosition(changed, scene->GetLocalPosition(changed) + glm::vec3(0.001f));
+            }
+            auto start = std::chrono::steady_clock::now();
+            scene->Update(0.0f);
+            elapsed += std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+            updatedCount += scene->GetUpdatedNodeCount();
+        }
+        SPDLOG_INFO("scene {}: {} nodes, {} changed, {} updated, {:.3f} ms/frame",
+            name, nodeCount, changeCount, updatedCount / frameCount, elapsed / frameCount);
+    };
+    measure("static", 0);
+    measure("1% dirty", std::max(1, nodeCount / 100));
+    measure("all dirty", nodeCount);
+    return 0;
+}
+
+int RunMeshBenchmark(const std::string& filename) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    if (!Mesh::LoadObj(filename, vertices, indices))
+        return -1;
+    // 최적화 전: 중복 정점만 제거한 원래 삼각형 순서
+    auto originalVertices = vertices;
+    auto originalIndices = indices;
+    MeshOptimizer::DeduplicateVertices(originalVertices, originalIndices);
+    Mesh::Optimize(vertices, indices);
+
+    /*
+        1. 소프트웨어 vertex 처리 단계
+           GPU처럼 FIFO post-transform cache에 없는 정점만 vertex shader를 실행하므로
+           삼각형 순서와 정점 배치가 처리 속도에 그대로 반영된다
+           cache는 정점별로 들어간 시각만 기록하여 O(1)로 확인하고 (MeshOptimizer의 시뮬레이터와 같은 방식)
+           vertex shader는 MVP 변환 + normal 변환 + Blinn-Phong 조명으로 실제 shader와 비슷한 비용을 낸다
+        2. 소프트웨어 rasterizer로 6개 방향에서 그린 overdraw와 rasterize 속도
+        3. MeshStorage에 같은 메쉬를 여러 개 올린 뒤 하나 건너 하나씩 해제하여
+           Free에서 일어나는 Defragment 횟수 / 시간과 arena 상태를 보고,
+           옮겨진 메쉬의 base vertex / index offset으로 읽은 데이터가 원본과 같은지 확인
+    */
+    auto model = glm::mat4(1.0f);
+    auto mvp = glm::perspective(glm::radians(45.0f), 1.0f, 0.01f, 100.0f) *
+        glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)) * model;
+    auto normalMatrix = glm::mat3(glm::transpose(glm::inverse(model)));
+    auto lightDirection = glm::normalize(glm::vec3(1.0f, 1.0f, 1.0f));
+    auto halfVector = glm::normalize(lightDirection + glm::vec3(0.0f, 0.0f, 1.0f));
+    struct TransformedVertex {
+        glm::vec4 position;
+        glm::vec3 normal;
+        glm::vec2 texCoord;
+        float light;
+    };
+    auto measure = [&](const char* name, const std::vector<Vertex>& vertices,
+        const std::vector<uint32_t>& indices) {
+        constexpr uint32_t kCacheSize = MeshOptimizer::kVertexCacheSize;
+        const int iterationCount = 20;
+        std::vector<uint32_t> cacheTime(vertices.size());
+        std::vector<TransformedVertex> transformed(vertices.size());
+        float checksum = 0.0f;
+        auto start = std::chrono::steady_clock::now();
+        for (int iteration = 0; iteration < iterationCount; iteration++) {
+            // 빈 cache에서 시작
+            std::fill(cacheTime.begin(), cacheTime.end(), 0);
+            uint32_t timestamp = kCacheSize + 1;
+            for (auto index : indices) {
+                auto& output = transformed[index];
+                if (timestamp - cacheTime[index] >= kCacheSize) {
+                    cacheTime[index] = timestamp++;
+                    auto& vertex = vertices[index];
+                    output.position = mvp * glm::vec4(vertex.position, 1.0f);
+                    output.normal = glm::normalize(normalMatrix * vertex.normal);
+                    output.texCoord = vertex.texCoord;
+                    float diffuse = std::max(glm::dot(output.normal, lightDirection), 0.0f);
+                    float specular = std::pow(std::max(glm::dot(output.normal, halfVector), 0.0f), 32.0f);
+                    output.light = 0.1f + diffuse + specular;
+                }
+                checksum += output.position.w + output.light;
+            }
+        }
+        double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        size_t triangleCount = indices.size() / 3 * iterationCount;
+        auto cacheStats = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+        SPDLOG_INFO("mesh {}: {} triangles, ACMR {:.3f}, ATVR {:.3f}, {:.2f} M triangles/s (checksum {})",
+            name, indices.size() / 3, cacheStats.acmr, cacheStats.atvr,
+            triangleCount / elapsed / 1e6, checksum);
+
+        start = std::chrono::steady_clock::now();
+        auto overdrawStats = MeshOptimizer::AnalyzeOverdraw(indices, vertices);
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        SPDLOG_INFO("mesh {}: overdraw {:.3f} ({} shaded / {} covered pixels), rasterizer {:.2f} M triangles/s",
+            name, overdrawStats.overdraw, overdrawStats.pixelsShaded, overdrawStats.pixelsCovered,
+            overdrawStats.triangleCount / elapsed / 1e6);
+    };
+    measure("original", originalVertices, originalIndices);
+    measure("optimized", vertices, indices);
+
+    // block 하나에 메쉬 여러 개가 들어가도록 block 크기를 메쉬 크기에 맞춘다
+    const int meshCount = 64;
+    size_t meshSize = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t);
+    auto storage = MeshStoragePtr(MeshStorage::Create(std::max<size_t>(meshSize * meshCount / 4, 1024 * 1024)));
+    std::vector<MeshUPtr> meshes;
+    for (int i = 0; i < meshCount; i++) {
+        auto mesh = Mesh::Create(vertices, indices, GL_TRIANGLES, {}, storage);
+        if (!mesh)
+            return -1;
+        meshes.push_back(std::move(mesh));
+    }
+    auto logArena = [](const char* name, const BufferArena* arena) {
+        auto stats = arena->GetStats();
+        SPDLOG_INFO("mesh storage {}: {} blocks, {} / {} bytes used, {} allocations, {} free ranges, "
+            "largest {} bytes, holes {} bytes (fragmentation {:.3f})",
+            name, stats.blockCount, stats.usedSize, stats.capacity, stats.allocationCount,
+            stats.freeRangeCount, stats.largestFreeRange, stats.holeSize,
+            MeshStorage::GetFragmentation(stats));
+    };
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < meshCount; i += 2)
+        meshes[i].reset();
+    glFinish();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    SPDLOG_INFO("mesh storage: freed {} / {} meshes in {:.3f} ms, {} defragments",
+        meshCount / 2, meshCount, elapsed * 1000.0, storage->GetDefragmentCount());
+    logArena("vertices", storage->GetVertexArena());
+    logArena("indices", storage->GetIndexArena());
+
+    // 남은 구멍까지 모두 정리
+    start = std::chrono::steady_clock::now();
+    storage->Defragment();
+    glFinish();
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    SPDLOG_INFO("mesh storage: defragment {:.3f} ms", elapsed * 1000.0);
+    logArena("vertices", storage->GetVertexArena());
+    logArena("indices", storage->GetIndexArena());
+
+    auto readBack = [](const BufferArena* arena, BufferArena::Handle handle, size_t offset, size_t size) {
+        std::vector<uint8_t> data(size);
+        RenderState::Get().BindBuffer(GL_COPY_READ_BUFFER,
+            arena->GetBuffer(arena->GetAllocation(handle).block)->Get());
+        glGetBufferSubData(GL_COPY_READ_BUFFER, offset, size, data.data());
+        RenderState::Get().BindBuffer(GL_COPY_READ_BUFFER, 0);
+        return data;
+    };
+    std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+    int mismatchCount = 0;
+    for (auto& mesh : meshes) {
+        if (!mesh)
+            continue;
+        auto& range = mesh->GetRange();
+        size_t vertexSize = vertices.size() * sizeof(Vertex);
+        size_t indexSize = indices.size() * mesh->GetIndexSize();
+        auto vertexData = readBack(storage->GetVertexArena(), range.vertices,
+            (size_t)mesh->GetBaseVertex() * sizeof(Vertex), vertexSize);
+        auto indexData = readBack(storage->GetIndexArena(), range.indices, mesh->GetIndexOffset(), indexSize);
+        const void* expectedIndices = mesh->GetIndexType() == GL_UNSIGNED_SHORT ?
+            (const void*)shortIndices.data() : (const void*)indices.data();
+        if (memcmp(vertexData.data(), vertices.data(), vertexSize) != 0 ||
+            memcmp(indexData.data(), expectedIndices, indexSize) != 0)
+            mismatchCount++;
+    }
+    if (mismatchCount > 0) {
+        SPDLOG_ERROR("mesh storage: {} meshes lost their data after defragment", mismatchCount);
+        return -1;
+    }
+    SPDLOG_INFO("mesh storage: {} meshes intact after defragment", meshCount / 2);
+    return 0;
+}
+
+int CookMesh(const std::string& input, const std::string& output) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    if (!Mesh::LoadObj(input, vertices, indices))
+        return -1;
+    Mesh::Optimize(vertices, indices);
+    auto lods = Mesh::GenerateLods(vertices, indices);
+    return MeshFile::Write(output, vertices, indices, lods, MeshVertexFormat::Quantized) ? 0 : -1;
+}
+
+int RunAtlasBenchmark(int imageCount) {
+    // 아이콘 / 재질 텍스처 크기 분포를 흉내내어 2의 거듭제곱과 임의 크기를 섞는다
+    std::mt19937 random(1234);
+    std::uniform_int_distribution<int> powerOfTwo(4, 8);
+    std::uniform_int_distribution<int> anySize(16, 256);
+    std::vector<glm::ivec2> sizes;
+    uint64_t imageArea = 0;
+    for (int i = 0; i < imageCount; i++) {
+        glm::ivec2 size = i % 2 == 0 ?
+            glm::ivec2(1 << powerOfTwo(random), 1 << powerOfTwo(random)) :
+            glm::ivec2(anySize(random), anySize(random));
+        sizes.push_back(size);
+        imageArea += (uint64_t)size.x * size.y;
+    }
+
+    const int padding = 8;
+    int width = 0, height = 0;
+    std::vector<glm::ivec2> positions;
+    auto start = std::chrono::steady_clock::now();
+    bool packed = TextureAtlas::Pack(sizes, 16384, padding, width, height, positions);
+    double elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    if (!packed) {
+        SPDLOG_ERROR("failed to pack {} images", imageCount);
+        return -1;
+    }
+    uint64_t paddedArea = 0;
+    for (auto& size : sizes)
+        paddedArea += (uint64_t)(size.x + padding * 2) * (size.y + padding * 2);
+    double atlasArea = (double)width * height;
+    SPDLOG_INFO("atlas: {} images, {}x{}, padding {}, {:.2f} ms, efficiency {:.1f}% ({:.1f}% with padding)",
+        imageCount, width, height, padding, elapsed,
+        100.0 * imageArea / atlasArea, 100.0 * paddedArea / atlasArea);
+    return 0;
+}
+
+// ImageOps 연산 목록. 제자리 연산은 전달받은 이미지를 수정해서 그대로 반환
+// sRGB 변환처럼 kernel 구분이 없는 연산은 simd가 false
+struct ImageOperation {
+    const char* name;
+    int channelCount; // benchmark에서 사용할 입력 채널 수
+    bool simd;
+    std::function<ImageUPtr(ImageUPtr, ImageOps::Kernel)> run;
+};
+
+std::vector<ImageOperation> GetImageOperations() {
+    using ImageOps::Kernel;
+    static const uint8_t color[4] = { 32, 64, 128, 255 };
+    return {
+        { "fill solid", 4, true, [](ImageUPtr image, Kernel kernel) {
+            ImageOps::FillSolid(image.get(), color, kernel); return image; } },
+        { "fill checker", 4, true, [](ImageUPtr image, Kernel kernel) {
+            ImageOps::FillChecker(image.get(), 8, 8, kernel); return image; } },
+        { "rgb to rgba", 3, true, [](ImageUPtr image, Kernel kernel) {
+            return ImageOps::ExpandToRgba(image.get(), kernel); } },
+        { "premultiply", 4, true, [](ImageUPtr image, Kernel kernel) {
+            ImageOps::PremultiplyAlpha(image.get(), kernel); return image; } },
+        { "srgb to linear", 4, false, [](ImageUPtr image, Kernel) {
+            ImageOps::SrgbToLinear(image.get()); return image; } },
+        { "linear to srgb", 4, false, [](ImageUPtr image, Kernel) {
+            ImageOps::LinearToSrgb(image.get()); return image; } },
+        { "flip vertical", 4, true, [](ImageUPtr image, Kernel kernel) {
+            ImageOps::FlipVertical(image.get(), kernel); return image; } },
+        { "downsample box", 4, true, [](ImageUPtr image, Kernel kernel) {
+            return ImageOps::Downsample(image.get(), ImageOps::MipFilter::Box, kernel); } },
+        { "downsample kaiser", 4, true, [](ImageUPtr image, Kernel kernel) {
+            return ImageOps::Downsample(image.get(), ImageOps::MipFilter::Kaiser, kernel); } },
+    };
+}
+
+ImageUPtr CreateRandomImage(int width, int height, int channelCount, std::mt19937& random) {
+    std::uniform_int_distribution<int> byte(0, 255);
+    auto image = Image::Create(width, height, channelCount);
+    for (size_t i = 0; i < (size_t)width * height * channelCount; i++)
+        image->GetData()[i] = (uint8_t)byte(random);
+    return std::move(image);
+}
+
+ImageUPtr CopyImage(const Image* source) {
+    auto image = Image::Create(source->GetWidth(), source->GetHeight(), source->GetChannelCount());
+    memcpy(image->GetData(), source->GetData(),
+        (size_t)image->GetWidth() * image->GetHeight() * image->GetChannelCount());
+    return std::move(image);
+}
+
+bool IsSameImage(const Image* a, const Image* b) {
+    return a->GetWidth() == b->GetWidth() && a->GetHeight() == b->GetHeight() &&
+        a->GetChannelCount() == b->GetChannelCount() &&
+        memcmp(a->GetData(), b->GetData(),
+            (size_t)a->GetWidth() * a->GetHeight() * a->GetChannelCount()) == 0;
+}
+
+int RunImageBenchmark(int size) {
+    // SIMD 경로의 나머지 처리도 지나도록 가로 세로를 vector 폭의 배수가 아닌 크기로
+    int width = size + 3;
+    int height = size + 1;
+    std::mt19937 random(1234);
+    ImageUPtr sources[5];
+    for (int channelCount = 1; channelCount <= 4; channelCount++)
+        sources[channelCount] = CreateRandomImage(width, height, channelCount, random);
+
+    using ImageOps::Kernel;
+    const int iterationCount = 10;
+    const Kernel kernels[3] = { Kernel::Scalar, Kernel::Sse2, Kernel::Avx2 };
+    double pixelCount = (double)width * height;
+    bool identical = true;
+    for (auto& operation : GetImageOperations()) {
+        const Image* source = sources[operation.channelCount].get();
+        ImageUPtr reference;
+        for (auto kernel : kernels) {
+            if (!operation.simd && kernel != Kernel::Scalar)
+                break;
+            if (!ImageOps::IsKernelSupported(kernel)) {
+                SPDLOG_INFO("{} {}: not supported on this cpu", operation.name,
+                    ImageOps::GetKernelName(kernel));
+                continue;
+            }
+            ImageUPtr result;
+            double elapsed = 0.0;
+            // 첫 실행은 table 생성 / 캐시 영향을 빼기 위해 측정에서 제외. 복사 시간도 제외
+            for (int i = 0; i <= iterationCount; i++) {
+                auto image = CopyImage(source);
+                auto start = std::chrono::steady_clock::now();
+                result = operation.run(std::move(image), kernel);
+                if (i > 0) {
+                    elapsed += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start).count();
+                }
+            }
+            elapsed /= iterationCount;
+            SPDLOG_INFO("{} {}: {}x{}, {:.3f} ms ({:.1f} MPix/s)", operation.name,
+                ImageOps::GetKernelName(kernel), width, height, elapsed,
+                pixelCount / elapsed / 1000.0);
+
+            if (!reference) {
+                reference = std::move(result);
+                continue;
+            }
+            if (!IsSameImage(result.get(), reference.get())) {
+                SPDLOG_ERROR("{}: {} result differs from scalar", operation.name,
+                    ImageOps::GetKernelName(kernel));
+                identical = false;
+            }
+        }
+    }
+    return identical ? 0 : -1;
+}
+
+int RunImageTest() {
+    /*
+        모든 연산을 1~4 채널, vector 폭의 배수가 아닌 여러 크기로 실행해서
+        SSE2 / AVX2 결과가 scalar와 bit 단위로 같은지 확인한다
+        가로는 한 픽셀부터 AVX2 vector 여러 개와 나머지를 모두 지나는 크기까지,
+        세로는 1 (downsample 최소 크기)과 홀수 / 짝수 행을 포함한다
+    */
+    using ImageOps::Kernel;
+    const Kernel kernels[2] = { Kernel::Sse2, Kernel::Avx2 };
+    const int widths[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 37, 63, 64, 65, 130 };
+    const int heights[] = { 1, 2, 3, 5, 8, 9, 17 };
+    std::mt19937 random(5678);
+    size_t testCount = 0;
+    size_t failCount = 0;
+    for (auto& operation : GetImageOperations()) {
+        if (!operation.simd)
+            continue;
+        for (int channelCount = 1; channelCount <= 4; channelCount++) {
+            for (int width : widths) {
+                for (int height : heights) {
+                    auto source = CreateRandomImage(width, height, channelCount, random);
+                    auto reference = operation.run(CopyImage(source.get()), Kernel::Scalar);
+                    for (auto kernel : kernels) {
+                        if (!ImageOps::IsKernelSupported(kernel))
+                            continue;
+                        auto result = operation.run(CopyImage(source.get()), kernel);
+                        testCount++;
+                        if (!reference || !result || !IsSameImage(result.get(), reference.get())) {
+                            SPDLOG_ERROR("{} {}: {}x{}x{} result differs from scalar", operation.name,
+                                ImageOps::GetKernelName(kernel), width, height, channelCount);
+                            failCount++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (auto kernel : kernels) {
+        if (!ImageOps::IsKernelSupported(kernel))
+            SPDLOG_WARN("{} kernel not supported on this cpu, not tested", ImageOps::GetKernelName(kernel));
+    }
+    SPDLOG_INFO("image test: {} / {} passed", testCount - failCount, testCount);
+    return failCount == 0 ? 0 : -1;
+}
+
+int RunShaderBenchmark(int programCount) {
+    /*
+        같은 수의 permutation을 두 방식으로 만든다
+        - sequential: 하나씩 컴파일 / link 하고 매번 결과를 기다림
+        - batch: 모두 요청한 뒤 한번에 기다림 (parallel shader compile 지원 시 driver thread에서 병렬 처리)
+        program binary 캐시는 끄고, driver 자체의 shader 캐시에 적중하지 않도록
+        실행마다 무작위로 시작하는 VARIANT 범위를 사용한다
+    */
+    std::random_device device;
+    int firstVariant = (int)(device() % 1000000);
+    auto measure = [&](const char* name, int variantOffset, bool batch) {
+        auto library = ShaderLibrary::Create("");
+        if (!library)
+            return false;
+        bool success = true;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < programCount; i++) {
+            ShaderDefines defines = { { "VARIANT", std::to_string(firstVariant + variantOffset + i) } };
+            auto program = batch ?
+                library->RequestProgram("./shader/texture.vs", "./shader/benchmark.fs", defines) :
+                library->GetProgram("./shader/texture.vs", "./shader/benchmark.fs", defines);
+            success = success && program;
+        }
+        success = library->WaitAll() && success;
+        glFinish();
+        double elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        SPDLOG_INFO("shader {}: {} programs, {:.2f} ms ({:.3f} ms/program)",
+            name, library->GetProgramCount(), elapsed, elapsed / programCount);
+        return success;
+    };
+    bool success = measure("sequential", 0, false);
+    success = measure("batch", programCount, true) && success;
+    if (!Program::IsParallelCompileSupported())
+        SPDLOG_INFO("parallel shader compile is not available, batch only defers the status checks");
+    return success ? 0 : -1;
+}
+
+int RunDrawBenchmark(int objectCount, int materialCount) {
+    // material 텍스처를 따로 두는 경우와 atlas / texture array 하나에 모으는 경우를 비교
+    const std::pair<MaterialPacking, const char*> packings[] = {
+        { MaterialPacking::None, "separate" },
+        { MaterialPacking::Atlas, "atlas" },
+        { MaterialPacking::Array, "array" },
+    };
+    auto& profiler = Profiler::Get();
+    const int warmupCount = 3;
+    const int frameCount = 20;
+    for (auto& [packing, packingName] : packings) {
+        auto context = Context::Create(objectCount, materialCount, packing);
+        if (!context)
+            return -1;
+        context->Reshape(WINDOW_WIDTH, WINDOW_HEIGHT);
+        // 텍스처 로딩이 끝난 뒤부터 측정. 로딩 중 올린 텍스처 양은 따로 보고
+        int loadingFrameCount = 0;
+        uint64_t textureUploadBytes = 0;
+        while (context->IsLoading()) {
+            profiler.BeginFrame();
+            context->Render();
+            profiler.EndFrame();
+            loadingFrameCount++;
+            textureUploadBytes += profiler.GetHistory().back().counters[(size_t)ProfileCounter::TextureUploadBytes];
+        }
+        SPDLOG_INFO("draw {}: loaded {} texture bytes in {} frames", packingName,
+            textureUploadBytes, loadingFrameCount);
+
+        // 모든 방식이 같은 장면을 그리도록 애니메이션 시간 고정
+        context->SetFixedTime(0.0);
+        for (bool instancing : { false, true }) {
+            context->SetInstancing(instancing);
+            for (int i = 0; i < warmupCount; i++)
+                context->Render();
+            double elapsed = 0.0;
+            uint64_t drawCalls = 0;
+            uint64_t triangles = 0;
+            uint64_t stateChanges = 0;
+            uint64_t stateChangesAvoided = 0;
+            uint64_t streamBytes = 0;
+            uint64_t fenceWait = 0;
+            for (int i = 0; i < frameCount; i++) {
+                profiler.BeginFrame();
+                auto start = std::chrono::steady_clock::now();
+                context->Render();
+                // GPU(software driver) 작업까지 포함한 프레임 시간
+                glFinish();
+                elapsed += std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start).count();
+                profiler.EndFrame();
+                auto& counters = profiler.GetHistory().back().counters;
+                drawCalls = counters[(size_t)ProfileCounter::DrawCall];
+                triangles = counters[(size_t)ProfileCounter::Triangle];
+                stateChanges = counters[(size_t)ProfileCounter::StateChange];
+                stateChangesAvoided = counters[(size_t)ProfileCounter::StateChangeAvoided];
+                streamBytes = counters[(size_t)ProfileCounter::StreamBytes];
+                fenceWait += counters[(size_t)ProfileCounter::FenceWait];
+            }
+            SPDLOG_INFO("draw {} {}: {} objects, {} visible, {} materials in {} textures, {} draw calls, "
+                "{} triangles, {} state changes ({} avoided), {} bytes streamed, {:.3f} ms fence wait, "
+                "{:.3f} ms/frame",
+                packingName, instancing ? "instanced" : "per-object", context->GetObjectCount(),
+                context->GetVisibleCount(), context->GetMaterialCount(), context->GetMaterialGroupCount(),
+                drawCalls, triangles, stateChanges, stateChangesAvoided, streamBytes,
+                fenceWait / 1000.0 / frameCount, elapsed / frameCount);
+        }
+    }
+    SPDLOG_INFO("GL renderer: {}", (const char*)glGetString(GL_RENDERER));
+    return 0;
+}
+
+int RunStartupBenchmark(int count) {
+    /*
+        시작 시 자원 로딩 시간을 측정한다
+        - texture: 같은 N개의 PNG / JPG 파일을 한 thread에서 순서대로 디코딩 / 업로드하는 경우와
+          TextureLoader로 thread pool에서 병렬 디코딩하는 경우 (업로드 예산 제한 없음)
+          병렬 로딩은 디스크 캐시 없이 / 빈 캐시로 (cold) / 채워진 캐시로 (warm) 각각 측정
+        - program: 빈 program binary 캐시로 시작하는 cold와 그 캐시를 다시 읽는 warm
+    */
+    namespace fs = std::filesystem;
+    const std::string directory = "./cache/startup_benchmark";
+    const std::string imageDirectory = directory + "/image";
+    std::error_code ec;
+    fs::create_directories(imageDirectory, ec);
+
+    // 벤치마크용 이미지는 없을 때만 만든다. 크기는 매번 같도록 고정된 seed 사용
+    std::mt19937 random(1234);
+    std::vector<std::string> files;
+    for (int i = 0; i < count; i++) {
+        int width = 128 + (int)(random() % 385);
+        int height = 128 + (int)(random() % 385);
+        auto filename = fmt::format("{}/{:04}.{}", imageDirectory, i, i % 2 ? "jpg" : "png");
+        files.push_back(filename);
+        if (fs::exists(filename, ec))
+            continue;
+        auto image = Image::Create(width, height, i % 2 ? 3 : 4);
+        if (!image)
+            return -1;
+        // 압축이 너무 잘 되지 않도록 gradient에 noise를 섞는다
+        uint8_t* data = image->GetData();
+        int channelCount = image->GetChannelCount();
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                for (int c = 0; c < channelCount; c++) {
+                    data[((size_t)y * width + x) * channelCount + c] =
+                        (uint8_t)(x * (c + 1) + y * (3 - c) + random() % 32);
+                }
+            }
+        }
+        if (!image->Save(filename))
+            return -1;
+    }
+
+    auto measure = [](const char* name, const std::function<bool()>& func) {
+        auto start = std::chrono::steady_clock::now();
+        bool success = func();
+        glFinish();
+        double elapsed = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        SPDLOG_INFO("startup {}: {:.2f} ms", name, elapsed);
+        return success;
+    };
+
+    std::vector<TexturePtr> textures;
+    bool success = measure("texture serial", [&]() {
+        for (auto& filename : files) {
+            auto image = Image::Load(filename);
+            if (!image)
+                return false;
+            textures.push_back(Texture::CreateFromImage(image.get()));
+        }
+        return true;
+    });
+    textures.clear();
+    // TextureLoader로 모든 텍스처가 교체될 때까지 업로드. 캐시 기록은 loader가 해제될 때까지 기다린다
+    auto loadParallel = [&](const std::string& cacheDirectory) {
+        auto loader = TextureLoader::Create(0, cacheDirectory);
+        if (!loader)
+            return false;
+        loader->GetStreamer()->SetFrameBudget(std::numeric_limits<size_t>::max());
+        for (auto& filename : files)
+            textures.push_back(loader->Load(filename));
+        while (loader->GetPendingCount() > 0) {
+            if (loader->Update() == 0)
+                std::this_thread::yield();
+        }
+        return true;
+    };
+    success = measure("texture parallel", [&]() { return loadParallel(""); }) && success;
+    textures.clear();
+    // 디스크 캐시: cold는 디코딩 후 캐시 기록, warm은 기록된 mip chain을 바로 업로드
+    const std::string textureCacheDirectory = directory + "/texture";
+    fs::remove_all(textureCacheDirectory, ec);
+    success = measure("texture cache cold", [&]() { return loadParallel(textureCacheDirectory); }) && success;
+    textures.clear();
+    success = measure("texture cache warm", [&]() { return loadParallel(textureCacheDirectory); }) && success;
+    textures.clear();
+
+    // driver의 shader 캐시에 적중하지 않도록 실행마다 무작위로 시작하는 VARIANT 범위 사용
+    const std::string programDirectory = directory + "/program";
+    fs::remove_all(programDirectory, ec);
+    std::random_device device;
+    int firstVariant = (int)(device() % 1000000);
+    for (const char* name : { "program cold", "program warm" }) {
+        ShaderLibraryUPtr library;
+        success = measure(name, [&]() {
+            library = ShaderLibrary::Create(programDirectory);
+            if (!library)
+                return false;
+            for (int i = 0; i < count; i++) {
+                ShaderDefines defines = { { "VARIANT", std::to_string(firstVariant + i) } };
+                library->RequestProgram("./shader/texture.vs", "./shader/benchmark.fs", defines);
+            }
+            return library->WaitAll();
+        }) && success;
+        if (library && library->GetProgramCache()) {
+            SPDLOG_INFO("startup {}: program cache {} hits, {} misses", name,
+                library->GetProgramCache()->GetHitCount(), library->GetProgramCache()->GetMissCount());
+        }
+        else if (library) {
+            SPDLOG_INFO("startup {}: program binary is not supported", name);
+        }
+    }
+    return success ? 0 : -1;
+}
+
 int main(int argc, const char** argv) {
     SPDLOG_INFO("Start program");
 
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+        return -1;
+    if (options.cullBenchmarkCount > 0)
+        return RunCullingBenchmark(options.cullBenchmarkCount);
+    if (options.sceneBenchmarkCount > 0)
+        return RunSceneBenchmark(options.sceneBenchmarkCount);
+    if (options.queueBenchmarkCount > 0)
+        return RunQueueBenchmark(options.queueBenchmarkCount);
+    if (!options.cookMeshInput.empty())
+        return CookMesh(options.cookMeshInput, options.cookMeshOutput);
+    if (options.atlasBenchmarkCount > 0)
+        return RunAtlasBenchmark(options.atlasBenchmarkCount);
+    if (options.imageBenchmarkSize > 0)
+        return RunImageBenchmark(options.imageBenchmarkSize);
+    if (options.imageTest)
+        return RunImageTest();
+
     // glfw 라이브러리 초기화, 실패하면 에러 출력 후 종료
     SPDLOG_INFO("Initialize glfw");
     if (!glfwInit()) {
@@ -57,6 +944,10 @@ int main(int argc, const char** argv) {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // headless / benchmark 모드에서는 보이지 않는 창의 context만 사용
+    if (options.headless || options.shaderBenchmarkCount > 0 || options.drawBenchmarkCount > 0 ||
+        options.startupBenchmarkCount > 0 || !options.meshBenchmarkFile.empty())
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     // glfw 윈도우 생성, 실패하면 에러 출력 후 종료
     SPDLOG_INFO("Create glfw window");
@@ -84,6 +975,31 @@ int main(int argc, const char** argv) {
     auto glVersion = glGetString(GL_VERSION);
     SPDLOG_INFO("OpenGL context version: {}", glVersion);
 
+    // MeshStorage의 Defragment를 확인하는 단계에 GL context가 필요
+    if (!options.meshBenchmarkFile.empty()) {
+        int result = RunMeshBenchmark(options.meshBenchmarkFile);
+        glfwTerminate();
+        return result;
+    }
+
+    if (options.shaderBenchmarkCount > 0) {
+        int result = RunShaderBenchmark(options.shaderBenchmarkCount);
+        glfwTerminate();
+        return result;
+    }
+
+    if (options.drawBenchmarkCount > 0) {
+        int result = RunDrawBenchmark(options.drawBenchmarkCount, options.materialCount);
+        glfwTerminate();
+        return result;
+    }
+
+    if (options.startupBenchmarkCount > 0) {
+        int result = RunStartupBenchmark(options.startupBenchmarkCount);
+        glfwTerminate();
+        return result;
+    }
+
     auto context = Context::Create();
     if (!context) {
         SPDLOG_ERROR("failed to create context");
@@ -91,6 +1007,13 @@ int main(int argc, const char** argv) {
         return -1;
     }
     
+    if (options.headless) {
+        int result = RunHeadless(context.get(), options);
+        context.reset();
+        glfwTerminate();
+        return result;
+    }
+
     // glfw callback 내에서 context 사용 
     //   - user pointer 기능을 이용
     glfwSetWindowUserPointer(window, context.get());
@@ -104,6 +1027,7 @@ int main(int argc, const char** argv) {
     // glfw 루프 실행, 윈도우 close 버튼을 누르면 정상 종료
     SPDLOG_INFO("Start main loop");
     while (!glfwWindowShouldClose(window)) {
+        Profiler::Get().BeginFrame();
         glfwPollEvents();
         
         context->ProcessInput(window);
@@ -118,6 +1042,7 @@ int main(int argc, const char** argv) {
           - 위의 과정을 반복
         */
         glfwSwapBuffers(window);
+        Profiler::Get().EndFrame();
     }
 
     context.reset();
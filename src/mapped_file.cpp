@@ -0,0 +1,72 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFileUPtr MappedFile::Open(const std::string& filename) {
+    auto file = MappedFileUPtr(new MappedFile());
+    if (!file->Map(filename))
+        return nullptr;
+    return std::move(file);
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (m_data && m_fallback.empty()) {
+        munmap((void*)m_data, m_size);
+    }
+#endif
+}
+
+#ifdef _WIN32
+bool MappedFile::Map(const std::string& filename) {
+    std::ifstream fin(filename, std::ios::binary | std::ios::ate);
+    if (!fin.is_open()) {
+        SPDLOG_ERROR("failed to open file: {}", filename);
+        return false;
+    }
+    m_size = (size_t)fin.tellg();
+    m_fallback.resize(m_size + 1);
+    fin.seekg(0);
+    fin.read((char*)m_fallback.data(), m_size);
+    m_data = m_fallback.data();
+    return true;
+}
+#else
+bool MappedFile::Map(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        SPDLOG_ERROR("failed to open file: {}", filename);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        SPDLOG_ERROR("failed to stat file: {}", filename);
+        close(fd);
+        return false;
+    }
+    m_size = (size_t)st.st_size;
+    if (m_size == 0) {
+        // 빈 파일은 mmap 할 수 없으므로 빈 버퍼를 가리킨다
+        close(fd);
+        m_fallback.resize(1);
+        m_data = m_fallback.data();
+        return true;
+    }
+    void* ptr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // 매핑이 유지되는 동안 fd는 필요 없음
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        SPDLOG_ERROR("failed to map file: {}", filename);
+        return false;
+    }
+    m_data = (const uint8_t*)ptr;
+    return true;
+}
+#endif
@@ -0,0 +1,29 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include "common.h"
+
+/*
+    읽기 전용으로 메모리에 매핑된 파일
+    Linux / macOS 에서는 mmap을 사용하여 유저 공간 복사 없이 파일 내용에 접근
+    그 외 플랫폼에서는 파일 전체를 한번 읽어 메모리에 보관한다
+*/
+CLASS_PTR(MappedFile)
+class MappedFile {
+public:
+    static MappedFileUPtr Open(const std::string& filename);
+    ~MappedFile();
+
+    const uint8_t* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    std::string_view GetText() const { return std::string_view((const char*)m_data, m_size); }
+
+private:
+    MappedFile() {}
+    bool Map(const std::string& filename);
+    const uint8_t* m_data { nullptr };
+    size_t m_size { 0 };
+    std::vector<uint8_t> m_fallback;
+};
+
+#endif // __MAPPED_FILE_H__
@@ -0,0 +1,268 @@
+#include "mesh.h"
+#include "mapped_file.h"
+#include "profiler.h"
+#include <cstdlib>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+MeshUPtr Mesh::Create(const std::vector<Vertex>& vertices,
+    const std::vector<uint32_t>& indices, uint32_t primitiveType,
+    const std::vector<MeshLod>& lods, MeshStoragePtr storage) {
+    auto mesh = MeshUPtr(new Mesh());
+    // 16bit로 표현 가능하면 index 메모리 / 대역폭을 절반으로
+    bool init = false;
+    if (vertices.size() <= 0x10000) {
+        std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        init = mesh->Init(storage, MeshVertexFormat::Float, vertices.data(), (uint32_t)vertices.size(),
+            GL_UNSIGNED_SHORT, shortIndices.data(), (uint32_t)shortIndices.size(), primitiveType);
+    }
+    else {
+        init = mesh->Init(storage, MeshVertexFormat::Float, vertices.data(), (uint32_t)vertices.size(),
+            GL_UNSIGNED_INT, indices.data(), (uint32_t)indices.size(), primitiveType);
+    }
+    if (!init)
+        return nullptr;
+    mesh->m_lods = lods;
+    if (mesh->m_lods.empty())
+        mesh->m_lods.push_back({ 0, (uint32_t)indices.size(), 0.0f });
+    return std::move(mesh);
+}
+
+MeshUPtr Mesh::CreateFromFile(const MeshFile* file, MeshStoragePtr storage) {
+    auto mesh = MeshUPtr(new Mesh());
+    if (!mesh->Init(storage, file->GetVertexFormat(), file->GetVertexData(), file->GetVertexCount(),
+        file->GetIndexType(), file->GetIndexData(), file->GetIndexCount(), GL_TRIANGLES))
+        return nullptr;
+    mesh->m_positionScale = file->GetPositionScale();
+    mesh->m_positionOffset = file->GetPositionOffset();
+    for (uint32_t i = 0; i < file->GetLodCount(); i++)
+        mesh->m_lods.push_back(file->GetLod(i));
+    return std::move(mesh);
+}
+
+MeshUPtr Mesh::Load(const std::string& filename, MeshStoragePtr storage,
+    const std::string& cacheDirectory) {
+    PROFILE_SCOPE("Mesh::Load");
+    if (fs::path(filename).extension() == ".mesh") {
+        auto file = MeshFile::Open(filename);
+        if (!file) {
+            SPDLOG_ERROR("failed to load mesh file: {}", filename);
+            return nullptr;
+        }
+        return CreateFromFile(file.get(), storage);
+    }
+
+    auto cachePath = fmt::format("{}/{:016x}.mesh", cacheDirectory, HashString(filename));
+    std::error_code ec;
+    if (fs::exists(cachePath, ec)) {
+        auto file = MeshFile::Open(cachePath);
+        if (file && file->IsUpToDate(filename))
+            return CreateFromFile(file.get(), storage);
+        // 손상되었거나 원본이 바뀐 캐시는 원본에서 다시 만든다
+        SPDLOG_INFO("mesh cache is invalid or out of date, regenerating: {}", cachePath);
+    }
+
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    if (!LoadObj(filename, vertices, indices))
+        return nullptr;
+    Optimize(vertices, indices);
+    auto lods = GenerateLods(vertices, indices);
+
+    // 캐시를 만들 수 없으면 float 정점 그대로 사용
+    fs::create_directories(cacheDirectory, ec);
+    if (!ec && MeshFile::Write(cachePath, vertices, indices, lods,
+        MeshVertexFormat::Quantized, filename)) {
+        auto file = MeshFile::Open(cachePath);
+        if (file)
+            return CreateFromFile(file.get(), storage);
+    }
+    return Create(vertices, indices, GL_TRIANGLES, lods, storage);
+}
+
+Mesh::~Mesh() {
+    if (m_storage)
+        m_storage->Free(m_range);
+}
+
+bool Mesh::Init(MeshStoragePtr storage, MeshVertexFormat vertexFormat, const void* vertexData,
+    uint32_t vertexCount, uint32_t indexType, const void* indexData, uint32_t indexCount,
+    uint32_t primitiveType) {
+    if (vertexCount == 0 || indexCount == 0) {
+        SPDLOG_ERROR("empty mesh");
+        return false;
+    }
+    m_primitiveType = primitiveType;
+    m_vertexFormat = vertexFormat;
+    m_vertexCount = vertexCount;
+    m_indexType = indexType;
+    m_indexCount = indexCount;
+
+    // 공유 storage가 없으면 데이터 크기에 맞는 block만 만드는 전용 storage
+    m_storage = storage ? storage : MeshStoragePtr(MeshStorage::Create(0));
+    size_t indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+    if (!m_storage->Allocate(vertexFormat, vertexData, vertexCount,
+        indexData, indexSize * indexCount, m_range)) {
+        m_storage = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void Mesh::Draw() const {
+    m_range.vertexLayout->Bind();
+    // LOD 0 (원본)
+    auto indexOffset = (const void*)(uintptr_t)(GetIndexOffset() + m_lods[0].indexOffset * GetIndexSize());
+    glDrawElementsBaseVertex(m_primitiveType, m_lods[0].indexCount, m_indexType,
+        indexOffset, GetBaseVertex());
+    PROFILE_COUNTER(DrawCall);
+    Profiler::Get().AddCounter(ProfileCounter::Triangle, m_lods[0].indexCount / 3);
+}
+
+std::vector<MeshLod> Mesh::GenerateLods(const std::vector<Vertex>& vertices,
+    std::vector<uint32_t>& indices) {
+    PROFILE_SCOPE("Mesh::GenerateLods");
+    std::vector<MeshLod> lods;
+    lods.push_back({ 0, (uint32_t)indices.size(), 0.0f });
+    // 이전 LOD를 다시 단순화하므로 LOD 사이의 모양이 일관적이다
+    std::vector<uint32_t> previous = indices;
+    while (lods.size() < kMaxMeshLodCount) {
+        float error = 0.0f;
+        auto simplified = MeshOptimizer::SimplifyMesh(vertices, previous, previous.size() / 2, &error);
+        // 경계 / seam 정점은 고정되므로 충분히 줄지 않으면 중단
+        if (simplified.empty() || simplified.size() > previous.size() * 9 / 10)
+            break;
+        MeshOptimizer::OptimizeVertexCache(simplified, vertices.size());
+        // 단순화를 이어서 적용하므로 오차의 상한은 누적된다
+        error += lods.back().error;
+        lods.push_back({ (uint32_t)indices.size(), (uint32_t)simplified.size(), error });
+        indices.insert(indices.end(), simplified.begin(), simplified.end());
+        previous.swap(simplified);
+    }
+    for (size_t i = 1; i < lods.size(); i++) {
+        SPDLOG_INFO("mesh lod {}: {} triangles, error {:.5f}",
+            i, lods[i].indexCount / 3, lods[i].error);
+    }
+    return lods;
+}
+
+void Mesh::Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    PROFILE_SCOPE("Mesh::Optimize");
+    size_t inputVertexCount = vertices.size();
+    MeshOptimizer::DeduplicateVertices(vertices, indices);
+    auto before = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+    MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+    MeshOptimizer::OptimizeOverdraw(indices, vertices);
+    MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+    auto after = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+    SPDLOG_INFO("mesh optimized: {} -> {} vertices, {} triangles, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+        inputVertexCount, vertices.size(), indices.size() / 3,
+        before.acmr, after.acmr, before.atvr, after.atvr);
+}
+
+// OBJ index는 1부터 시작하고 음수이면 뒤에서부터 센다
+static int32_t ResolveObjIndex(long index, size_t count) {
+    if (index > 0)
+        return (int32_t)index - 1;
+    if (index < 0)
+        return (int32_t)(count + index);
+    return -1;
+}
+
+bool Mesh::LoadObj(const std::string& filename,
+    std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    auto file = MappedFile::Open(filename);
+    if (!file) {
+        SPDLOG_ERROR("failed to open mesh: {}", filename);
+        return false;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<glm::vec2> texCoords;
+    std::vector<Vertex> polygon;
+    std::string line;
+    auto text = file->GetText();
+    size_t lineNumber = 0;
+    while (!text.empty()) {
+        lineNumber++;
+        size_t lineEnd = text.find('\n');
+        // strtof / strtol이 null 종료 문자열을 요구하므로 한 줄씩 복사
+        line.assign(text.substr(0, lineEnd));
+        text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+
+        const char* cursor = line.c_str();
+        char* next = nullptr;
+        if (line.compare(0, 2, "v ") == 0) {
+            glm::vec3 position;
+            cursor += 2;
+            for (int i = 0; i < 3; i++, cursor = next)
+                position[i] = std::strtof(cursor, &next);
+            positions.push_back(position);
+        }
+        else if (line.compare(0, 3, "vn ") == 0) {
+            glm::vec3 normal;
+            cursor += 3;
+            for (int i = 0; i < 3; i++, cursor = next)
+                normal[i] = std::strtof(cursor, &next);
+            normals.push_back(normal);
+        }
+        else if (line.compare(0, 3, "vt ") == 0) {
+            glm::vec2 texCoord;
+            cursor += 3;
+            for (int i = 0; i < 2; i++, cursor = next)
+                texCoord[i] = std::strtof(cursor, &next);
+            texCoords.push_back(texCoord);
+        }
+        else if (line.compare(0, 2, "f ") == 0) {
+            // v, v/vt, v//vn, v/vt/vn 형식의 꼭지점을 모은 뒤 fan으로 삼각형 분할
+            polygon.clear();
+            cursor += 2;
+            while (true) {
+                long index = std::strtol(cursor, &next, 10);
+                if (next == cursor)
+                    break;
+                cursor = next;
+                Vertex vertex = {};
+                int32_t position = ResolveObjIndex(index, positions.size());
+                if (position < 0 || position >= (int32_t)positions.size()) {
+                    SPDLOG_ERROR("invalid vertex index: {}:{}", filename, lineNumber);
+                    return false;
+                }
+                vertex.position = positions[position];
+                if (*cursor == '/') {
+                    cursor++;
+                    if (*cursor != '/') {
+                        int32_t texCoord = ResolveObjIndex(std::strtol(cursor, &next, 10), texCoords.size());
+                        cursor = next;
+                        if (texCoord >= 0 && texCoord < (int32_t)texCoords.size())
+                            vertex.texCoord = texCoords[texCoord];
+                    }
+                    if (*cursor == '/') {
+                        cursor++;
+                        int32_t normal = ResolveObjIndex(std::strtol(cursor, &next, 10), normals.size());
+                        cursor = next;
+                        if (normal >= 0 && normal < (int32_t)normals.size())
+                            vertex.normal = normals[normal];
+                    }
+                }
+                polygon.push_back(vertex);
+            }
+            for (size_t i = 1; i + 1 < polygon.size(); i++) {
+                for (size_t k : { (size_t)0, i, i + 1 }) {
+                    indices.push_back((uint32_t)vertices.size());
+                    vertices.push_back(polygon[k]);
+                }
+            }
+        }
+    }
+
+    if (indices.empty()) {
+        SPDLOG_ERROR("no faces in mesh: {}", filename);
+        return false;
+    }
+    SPDLOG_INFO("mesh loaded: {} ({} positions, {} triangles)",
+        filename, positions.size(), indices.size() / 3);
+    return true;
+}
@@ -0,0 +1,87 @@
+#ifndef __MESH_H__
+#define __MESH_H__
+
+#include "mesh_storage.h"
+#include "mesh_optimizer.h"
+
+/*
+    정점 / 인덱스 버퍼와 vertex layout을 함께 소유하는 메쉬
+    attribute location: 0 = position, 1 = normal, 2 = texCoord
+    양자화된 메쉬의 normal은 octahedral encoding된 vec2이므로 shader에 PACKED_NORMAL을 정의해 복원한다
+    정점 수가 65536개 이하이면 16bit index를 사용한다
+    양자화된 메쉬의 position은 shader에서 positionOffset + positionScale * aPos 로 복원한다
+    (float 메쉬는 scale 1, offset 0)
+    LOD는 같은 정점을 공유하고 index buffer 안의 구간만 다르다 (0이 원본)
+    정점 / 인덱스는 MeshStorage의 arena 구간에 올리므로 같은 storage의 메쉬는 VAO를 공유하고
+    GetIndexOffset / GetBaseVertex를 더해 glDrawElementsBaseVertex로 그린다
+    storage를 주지 않으면 메쉬 혼자 쓰는 storage를 만든다
+*/
+CLASS_PTR(Mesh)
+class Mesh {
+public:
+    // lods가 비어있으면 indices 전체를 LOD 하나로 사용
+    static MeshUPtr Create(const std::vector<Vertex>& vertices,
+        const std::vector<uint32_t>& indices, uint32_t primitiveType = GL_TRIANGLES,
+        const std::vector<MeshLod>& lods = {}, MeshStoragePtr storage = nullptr);
+    // mmap한 .mesh 파일의 데이터를 그대로 GPU 버퍼에 올린다
+    static MeshUPtr CreateFromFile(const MeshFile* file, MeshStoragePtr storage = nullptr);
+    /*
+        .mesh 파일은 바로 읽고, OBJ 파일은 최적화(MeshOptimizer)와 양자화를 거친
+        .mesh 파일을 cacheDirectory에 만들어 두고 다음부터는 그것을 읽는다
+    */
+    static MeshUPtr Load(const std::string& filename, MeshStoragePtr storage = nullptr,
+        const std::string& cacheDirectory = "./cache/mesh");
+    // OBJ 파일을 정점 / 인덱스 배열로 읽는다 (최적화 전, 면의 꼭지점마다 정점 하나)
+    static bool LoadObj(const std::string& filename,
+        std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+    // 최적화 단계를 순서대로 적용하고 전후 vertex cache 통계를 로그로 출력
+    static void Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+    /*
+        최적화가 끝난 indices(LOD 0)를 단순화해 삼각형 수가 절반씩 줄어드는 LOD를 만들고
+        indices 뒤에 이어붙인다. 더 줄어들지 않으면 그 전까지만 생성
+    */
+    static std::vector<MeshLod> GenerateLods(const std::vector<Vertex>& vertices,
+        std::vector<uint32_t>& indices);
+
+    ~Mesh();
+
+    // storage가 공유하는 VAO
+    const VertexLayout* GetVertexLayout() const { return m_range.vertexLayout; }
+    const MeshStorage* GetStorage() const { return m_storage.get(); }
+    const MeshRange& GetRange() const { return m_range; }
+    // index buffer 안에서 이 메쉬의 index가 시작하는 byte offset
+    // storage의 Defragment로 바뀔 수 있으므로 그릴 때마다 조회한다
+    uint32_t GetIndexOffset() const { return m_storage->GetIndexOffset(m_range); }
+    int32_t GetBaseVertex() const { return m_storage->GetBaseVertex(m_range); }
+    uint32_t GetPrimitiveType() const { return m_primitiveType; }
+    uint32_t GetIndexType() const { return m_indexType; }
+    uint32_t GetIndexCount() const { return m_indexCount; }
+    uint32_t GetVertexCount() const { return m_vertexCount; }
+    MeshVertexFormat GetVertexFormat() const { return m_vertexFormat; }
+    const glm::vec3& GetPositionScale() const { return m_positionScale; }
+    const glm::vec3& GetPositionOffset() const { return m_positionOffset; }
+    uint32_t GetIndexSize() const { return m_indexType == GL_UNSIGNED_SHORT ? 2 : 4; }
+    uint32_t GetLodCount() const { return (uint32_t)m_lods.size(); }
+    const MeshLod& GetLod(uint32_t lod) const { return m_lods[lod]; }
+
+    void Draw() const;
+
+private:
+    Mesh() {}
+    bool Init(MeshStoragePtr storage, MeshVertexFormat vertexFormat, const void* vertexData,
+        uint32_t vertexCount, uint32_t indexType, const void* indexData, uint32_t indexCount,
+        uint32_t primitiveType);
+
+    uint32_t m_primitiveType { GL_TRIANGLES };
+    uint32_t m_indexType { GL_UNSIGNED_INT };
+    uint32_t m_indexCount { 0 };
+    uint32_t m_vertexCount { 0 };
+    MeshVertexFormat m_vertexFormat { MeshVertexFormat::Float };
+    glm::vec3 m_positionScale { glm::vec3(1.0f) };
+    glm::vec3 m_positionOffset { glm::vec3(0.0f) };
+    std::vector<MeshLod> m_lods;
+    MeshStoragePtr m_storage;
+    MeshRange m_range;
+};
+
+#endif // __MESH_H__
@@ -0,0 +1,198 @@
+#include "mesh_file.h"
+#include "profiler.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+static constexpr uint32_t kMeshFileMagic = 0x4853454d; // "MESH"
+static constexpr uint32_t kMeshFileVersion = 2;
+
+MeshFileUPtr MeshFile::Open(const std::string& filename) {
+    auto meshFile = MeshFileUPtr(new MeshFile());
+    if (!meshFile->Init(filename))
+        return nullptr;
+    return std::move(meshFile);
+}
+
+bool MeshFile::Init(const std::string& filename) {
+    m_file = MappedFile::Open(filename);
+    if (!m_file || m_file->GetSize() < sizeof(MeshFileHeader))
+        return false;
+    m_header = (const MeshFileHeader*)m_file->GetData();
+    if (m_header->magic != kMeshFileMagic || m_header->version != kMeshFileVersion)
+        return false;
+    // 헤더 값으로 버퍼 크기와 attribute 형식을 정하므로 파일 크기 / enum 값을 모두 확인한다
+    uint64_t stride = 0;
+    switch ((MeshVertexFormat)m_header->vertexFormat) {
+        case MeshVertexFormat::Float: stride = sizeof(Vertex); break;
+        case MeshVertexFormat::Quantized: stride = sizeof(PackedVertex); break;
+    }
+    uint64_t indexSize = 0;
+    switch (m_header->indexType) {
+        case GL_UNSIGNED_SHORT: indexSize = sizeof(uint16_t); break;
+        case GL_UNSIGNED_INT: indexSize = sizeof(uint32_t); break;
+    }
+    // offset + size는 덧셈 overflow가 없도록 뺄셈으로 비교
+    uint64_t fileSize = m_file->GetSize();
+    if (stride == 0 || indexSize == 0 ||
+        m_header->vertexSize != m_header->vertexCount * stride ||
+        m_header->indexSize != m_header->indexCount * indexSize ||
+        m_header->vertexOffset > fileSize || m_header->vertexSize > fileSize - m_header->vertexOffset ||
+        m_header->indexOffset > fileSize || m_header->indexSize > fileSize - m_header->indexOffset ||
+        m_header->lodCount == 0 || m_header->lodCount > kMaxMeshLodCount) {
+        SPDLOG_ERROR("corrupted mesh file: {}", filename);
+        return false;
+    }
+    // LOD 구간은 index buffer 안에 있어야 한다
+    for (uint32_t i = 0; i < m_header->lodCount; i++) {
+        auto& lod = m_header->lods[i];
+        if ((uint64_t)lod.indexOffset + lod.indexCount > m_header->indexCount) {
+            SPDLOG_ERROR("corrupted mesh file: {} (lod {} out of range)", filename, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MeshFile::IsUpToDate(const std::string& sourceFilename) const {
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (!GetFileStamp(sourceFilename, sourceSize, sourceTime))
+        return false;
+    return m_header->sourceSize == sourceSize && m_header->sourceTime == sourceTime;
+}
+
+static int16_t PackSnorm16(float value) {
+    return (int16_t)glm::round(glm::clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
+// 단위 벡터를 팔면체에 투영한 뒤 아래쪽 반을 펼쳐 [-1, 1]^2 에 대응시킨다
+static glm::vec2 EncodeOctahedral(const glm::vec3& normal) {
+    float sum = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+    if (sum == 0.0f)
+        return glm::vec2(0.0f);
+    glm::vec3 n = normal / sum;
+    if (n.z >= 0.0f)
+        return glm::vec2(n.x, n.y);
+    return glm::vec2(
+        (1.0f - glm::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+        (1.0f - glm::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+}
+
+bool MeshFile::Write(const std::string& filename,
+    const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+    const std::vector<MeshLod>& lods, MeshVertexFormat format, const std::string& sourceFilename) {
+    PROFILE_SCOPE("MeshFile::Write");
+    MeshFileHeader header = {};
+    header.magic = kMeshFileMagic;
+    header.version = kMeshFileVersion;
+    if (!sourceFilename.empty() &&
+        !GetFileStamp(sourceFilename, header.sourceSize, header.sourceTime))
+        return false;
+    header.vertexFormat = (uint32_t)format;
+    header.vertexCount = (uint32_t)vertices.size();
+    header.indexCount = (uint32_t)indices.size();
+    // LOD 정보가 없으면 전체를 LOD 하나로 취급
+    header.lodCount = std::min((uint32_t)lods.size(), kMaxMeshLodCount);
+    for (uint32_t i = 0; i < header.lodCount; i++)
+        header.lods[i] = lods[i];
+    if (header.lodCount == 0) {
+        header.lodCount = 1;
+        header.lods[0] = { 0, header.indexCount, 0.0f };
+    }
+
+    // 위치 양자화에 사용할 bounding box. 두께가 0인 축은 scale 1로 둔다
+    glm::vec3 boundsMin(0.0f);
+    glm::vec3 boundsMax(0.0f);
+    if (!vertices.empty()) {
+        boundsMin = boundsMax = vertices[0].position;
+        for (auto& vertex : vertices) {
+            boundsMin = glm::min(boundsMin, vertex.position);
+            boundsMax = glm::max(boundsMax, vertex.position);
+        }
+    }
+    glm::vec3 scale(1.0f);
+    glm::vec3 offset(0.0f);
+    if (format == MeshVertexFormat::Quantized) {
+        offset = (boundsMin + boundsMax) * 0.5f;
+        scale = (boundsMax - boundsMin) * 0.5f;
+        for (int i = 0; i < 3; i++) {
+            if (scale[i] <= 0.0f)
+                scale[i] = 1.0f;
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        header.positionScale[i] = scale[i];
+        header.positionOffset[i] = offset[i];
+    }
+
+    std::vector<PackedVertex> packedVertices;
+    const void* vertexData = vertices.data();
+    header.vertexSize = sizeof(Vertex) * vertices.size();
+    if (format == MeshVertexFormat::Quantized) {
+        packedVertices.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++) {
+            auto& vertex = vertices[i];
+            auto& packed = packedVertices[i];
+            auto position = (vertex.position - offset) / scale;
+            auto normal = EncodeOctahedral(vertex.normal);
+            for (int k = 0; k < 3; k++)
+                packed.position[k] = PackSnorm16(position[k]);
+            packed.position[3] = 0;
+            packed.normal[0] = PackSnorm16(normal.x);
+            packed.normal[1] = PackSnorm16(normal.y);
+            packed.texCoord[0] = glm::packHalf1x16(vertex.texCoord.x);
+            packed.texCoord[1] = glm::packHalf1x16(vertex.texCoord.y);
+        }
+        vertexData = packedVertices.data();
+        header.vertexSize = sizeof(PackedVertex) * packedVertices.size();
+    }
+
+    std::vector<uint16_t> shortIndices;
+    const void* indexData = indices.data();
+    header.indexType = GL_UNSIGNED_INT;
+    header.indexSize = sizeof(uint32_t) * indices.size();
+    if (vertices.size() <= 0x10000) {
+        shortIndices.assign(indices.begin(), indices.end());
+        indexData = shortIndices.data();
+        header.indexType = GL_UNSIGNED_SHORT;
+        header.indexSize = sizeof(uint16_t) * shortIndices.size();
+    }
+    header.vertexOffset = sizeof(MeshFileHeader);
+    // index 데이터는 4byte 정렬 위치에서 시작
+    header.indexOffset = (header.vertexOffset + header.vertexSize + 3) & ~(uint64_t)3;
+
+    // 쓰는 도중의 파일을 읽지 않도록 임시 파일에 쓴 뒤 이름을 바꾼다
+    auto tempFilename = filename + ".tmp";
+    {
+        std::ofstream fout(tempFilename, std::ios::binary);
+        if (!fout.is_open()) {
+            SPDLOG_ERROR("failed to write mesh file: {}", tempFilename);
+            return false;
+        }
+        const char padding[4] = {};
+        fout.write((const char*)&header, sizeof(header));
+        fout.write((const char*)vertexData, header.vertexSize);
+        fout.write(padding, header.indexOffset - header.vertexOffset - header.vertexSize);
+        fout.write((const char*)indexData, header.indexSize);
+        if (!fout.good()) {
+            SPDLOG_ERROR("failed to write mesh file: {}", tempFilename);
+            // 일부만 기록된 임시 파일을 남기지 않는다
+            fout.close();
+            std::error_code ec;
+            std::filesystem::remove(tempFilename, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempFilename, filename, ec);
+    if (ec) {
+        SPDLOG_ERROR("failed to write mesh file: {}", filename);
+        std::filesystem::remove(tempFilename, ec);
+        return false;
+    }
+    SPDLOG_INFO("mesh file written: {} ({} vertices, {} bytes/vertex)", filename,
+        header.vertexCount, format == MeshVertexFormat::Quantized ? sizeof(PackedVertex) : sizeof(Vertex));
+    return true;
+}
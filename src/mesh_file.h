@@ -0,0 +1,92 @@
+#ifndef __MESH_FILE_H__
+#define __MESH_FILE_H__
+
+#include "mesh_optimizer.h"
+#include "mapped_file.h"
+
+enum class MeshVertexFormat : uint32_t {
+    Float = 0,     // Vertex (32 byte)
+    Quantized = 1, // PackedVertex (16 byte)
+};
+
+/*
+    양자화된 정점 (16 byte)
+    position: bounding box 기준으로 정규화한 snorm16. 실제 위치 = offset + scale * position
+    normal: octahedral encoding한 단위 벡터를 snorm16 2개로 저장
+    texCoord: half float 2개. 타일링을 위해 [0, 1] 밖의 값도 표현할 수 있다
+*/
+struct PackedVertex {
+    int16_t position[4]; // w는 4byte 정렬용 (항상 0)
+    int16_t normal[2];
+    uint16_t texCoord[2];
+};
+
+// 하나의 index buffer 안에서 LOD가 차지하는 구간 (index 단위)
+struct MeshLod {
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    float error; // 원본 대비 최대 오차 (메쉬 좌표계의 거리)
+};
+
+static constexpr uint32_t kMaxMeshLodCount = 4;
+
+/*
+    미리 변환해 둔 바이너리 메쉬 파일 (.mesh)
+    파일 구조: MeshFileHeader | vertex data | index data (모든 LOD를 이어붙임)
+    정점 / 인덱스는 GPU 버퍼 형식 그대로 저장되어 있으므로
+    mmap한 데이터를 파싱 없이 바로 glBufferData에 넘길 수 있다
+*/
+struct MeshFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceSize; // 변환한 원본 파일의 크기 / 수정 시간. 없으면 0
+    int64_t sourceTime;
+    uint32_t vertexFormat;
+    uint32_t vertexCount;
+    uint32_t indexType;
+    uint32_t indexCount;
+    float positionScale[3];
+    float positionOffset[3];
+    uint64_t vertexOffset;
+    uint64_t vertexSize;
+    uint64_t indexOffset;
+    uint64_t indexSize;
+    uint32_t lodCount;
+    MeshLod lods[kMaxMeshLodCount];
+};
+
+CLASS_PTR(MeshFile)
+class MeshFile {
+public:
+    static MeshFileUPtr Open(const std::string& filename);
+    // 정점 / 인덱스를 GPU 형식으로 변환해 저장
+    // sourceFilename을 주면 캐시 유효성 검사를 위해 원본 파일 정보를 함께 기록
+    static bool Write(const std::string& filename,
+        const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+        const std::vector<MeshLod>& lods, MeshVertexFormat format,
+        const std::string& sourceFilename = "");
+
+    // 원본 파일이 변환한 이후 바뀌지 않았는지
+    bool IsUpToDate(const std::string& sourceFilename) const;
+
+    MeshVertexFormat GetVertexFormat() const { return (MeshVertexFormat)m_header->vertexFormat; }
+    uint32_t GetVertexCount() const { return m_header->vertexCount; }
+    const void* GetVertexData() const { return m_file->GetData() + m_header->vertexOffset; }
+    size_t GetVertexDataSize() const { return m_header->vertexSize; }
+    uint32_t GetIndexType() const { return m_header->indexType; }
+    uint32_t GetIndexCount() const { return m_header->indexCount; }
+    const void* GetIndexData() const { return m_file->GetData() + m_header->indexOffset; }
+    size_t GetIndexDataSize() const { return m_header->indexSize; }
+    uint32_t GetLodCount() const { return m_header->lodCount; }
+    const MeshLod& GetLod(uint32_t lod) const { return m_header->lods[lod]; }
+    glm::vec3 GetPositionScale() const { return glm::make_vec3(m_header->positionScale); }
+    glm::vec3 GetPositionOffset() const { return glm::make_vec3(m_header->positionOffset); }
+
+private:
+    MeshFile() {}
+    bool Init(const std::string& filename);
+    MappedFileUPtr m_file;
+    const MeshFileHeader* m_header { nullptr };
+};
+
+#endif // __MESH_FILE_H__
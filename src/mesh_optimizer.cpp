@@ -0,0 +1,638 @@
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+namespace MeshOptimizer {
+
+namespace {
+
+// 정점을 byte 단위로 비교 / 해시하기 위한 key
+struct VertexKey {
+    const Vertex* vertex;
+    bool operator==(const VertexKey& other) const {
+        return memcmp(vertex, other.vertex, sizeof(Vertex)) == 0;
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        return (size_t)HashString(std::string_view((const char*)key.vertex, sizeof(Vertex)));
+    }
+};
+
+/*
+    FIFO post-transform cache 시뮬레이터
+    정점이 cache에 들어간 시각(timestamp)만 기록해 두면
+    현재 시각과의 차이가 cache 크기보다 작을 때 cache에 남아있는 것
+*/
+class FifoCache {
+public:
+    FifoCache(size_t vertexCount, uint32_t cacheSize)
+        : m_cacheTime(vertexCount, 0), m_cacheSize(cacheSize), m_timestamp(cacheSize + 1) {}
+
+    bool Contains(uint32_t vertex) const { return m_timestamp - m_cacheTime[vertex] < m_cacheSize; }
+    // 캐시에 없으면 추가하고 true (miss) 를 돌려준다
+    bool Access(uint32_t vertex) {
+        if (Contains(vertex))
+            return false;
+        m_cacheTime[vertex] = m_timestamp++;
+        return true;
+    }
+    // 모든 정점을 cache에서 밀어냄
+    void Flush() { m_timestamp += m_cacheSize + 1; }
+
+private:
+    std::vector<uint32_t> m_cacheTime;
+    uint32_t m_cacheSize;
+    uint32_t m_timestamp;
+};
+
+/*
+    평면까지 거리의 제곱합을 나타내는 quadric (Garland & Heckbert 1997)
+    대칭 4x4 행렬이므로 상삼각 성분 10개만 저장
+    weight: 누적된 면적. 오차를 거리 단위로 바꿀 때 사용
+*/
+struct Quadric {
+    double a00 { 0 }, a01 { 0 }, a02 { 0 }, a03 { 0 };
+    double a11 { 0 }, a12 { 0 }, a13 { 0 };
+    double a22 { 0 }, a23 { 0 };
+    double a33 { 0 };
+    double weight { 0 };
+
+    // 평면 ax + by + cz + d = 0 (법선은 정규화)
+    static Quadric FromPlane(double a, double b, double c, double d, double weight) {
+        Quadric q;
+        q.a00 = a * a * weight; q.a01 = a * b * weight; q.a02 = a * c * weight; q.a03 = a * d * weight;
+        q.a11 = b * b * weight; q.a12 = b * c * weight; q.a13 = b * d * weight;
+        q.a22 = c * c * weight; q.a23 = c * d * weight;
+        q.a33 = d * d * weight;
+        q.weight = weight;
+        return q;
+    }
+
+    void Add(const Quadric& q) {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+        a11 += q.a11; a12 += q.a12; a13 += q.a13;
+        a22 += q.a22; a23 += q.a23;
+        a33 += q.a33;
+        weight += q.weight;
+    }
+
+    // (x, y, z, 1)^T Q (x, y, z, 1)
+    double Evaluate(const glm::vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        return a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x +
+            a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y +
+            a22 * z * z + 2.0 * a23 * z +
+            a33;
+    }
+};
+
+} // namespace
+
+void DeduplicateVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> uniqueIndices;
+    uniqueIndices.reserve(vertices.size());
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<Vertex> uniqueVertices;
+    uniqueVertices.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        // key는 원본 배열의 정점을 가리키므로 원본은 마지막에 교체한다
+        auto result = uniqueIndices.emplace(VertexKey { &vertices[i] }, (uint32_t)uniqueVertices.size());
+        if (result.second)
+            uniqueVertices.push_back(vertices[i]);
+        remap[i] = result.first->second;
+    }
+    for (auto& index : indices)
+        index = remap[index];
+    vertices.swap(uniqueVertices);
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+    /*
+        Tipsify (Sander et al. 2007)
+        한 정점(fanning vertex)에 붙은 삼각형을 모두 출력한 뒤, 방금 출력한 정점 중
+        cache에 남아있고 남은 삼각형이 있는 정점으로 넘어간다.
+        그런 정점이 없으면(dead end) 최근 출력한 정점 또는 다음 순서의 정점에서 다시 시작
+    */
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // 정점별 인접 삼각형 목록 (CSR 형태)
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (auto index : indices)
+        liveTriangles[index]++;
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++)
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            adjacency[fill[indices[i]]++] = (uint32_t)(i / 3);
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEndStack;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    uint32_t timestamp = cacheSize + 1;
+    uint32_t cursor = 0;
+    int64_t fanning = 0;
+    while (fanning >= 0) {
+        candidates.clear();
+        for (uint32_t a = adjacencyOffsets[fanning]; a < adjacencyOffsets[fanning + 1]; a++) {
+            uint32_t triangle = adjacency[a];
+            if (emitted[triangle])
+                continue;
+            for (uint32_t k = 0; k < 3; k++) {
+                uint32_t v = indices[triangle * 3 + k];
+                result.push_back(v);
+                deadEndStack.push_back(v);
+                candidates.push_back(v);
+                liveTriangles[v]--;
+                if (timestamp - cacheTime[v] > cacheSize)
+                    cacheTime[v] = timestamp++;
+            }
+            emitted[triangle] = 1;
+        }
+
+        // 남은 삼각형을 모두 출력해도 cache에 남아있을 정점 중 가장 오래된 것을 선택
+        int64_t next = -1;
+        int64_t bestPriority = -1;
+        for (auto v : candidates) {
+            if (liveTriangles[v] == 0)
+                continue;
+            int64_t priority = 0;
+            if (timestamp - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize)
+                priority = timestamp - cacheTime[v];
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+        if (next < 0) {
+            while (!deadEndStack.empty()) {
+                uint32_t v = deadEndStack.back();
+                deadEndStack.pop_back();
+                if (liveTriangles[v] > 0) {
+                    next = v;
+                    break;
+                }
+            }
+        }
+        if (next < 0) {
+            while (cursor < vertexCount && liveTriangles[cursor] == 0)
+                cursor++;
+            if (cursor < vertexCount)
+                next = cursor;
+        }
+        fanning = next;
+    }
+    indices.swap(result);
+}
+
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+    float threshold, uint32_t cacheSize) {
+    /*
+        cache 최적화가 끝난 index를 cluster로 나누고, cluster 단위로
+        메쉬 중심에서 바깥쪽을 향하는 것부터 그린다 (Sander et al. 2007)
+        - hard boundary: 세 정점 모두 cache miss인 삼각형 (Tipsify가 새로 시작한 지점)
+        - soft boundary: hard cluster 안에서 ACMR이 cluster 전체의 threshold배 이하로 유지되는 지점
+        cluster 경계에서만 순서를 바꾸므로 cache 효율은 threshold 이내로 유지된다
+    */
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    std::vector<uint32_t> triangleMisses(triangleCount);
+    {
+        FifoCache cache(vertices.size(), cacheSize);
+        for (size_t t = 0; t < triangleCount; t++) {
+            triangleMisses[t] = 0;
+            for (uint32_t k = 0; k < 3; k++)
+                triangleMisses[t] += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+        }
+    }
+
+    std::vector<size_t> hardBoundaries;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (t == 0 || triangleMisses[t] == 3)
+            hardBoundaries.push_back(t);
+    }
+    hardBoundaries.push_back(triangleCount);
+
+    // 순서가 바뀌면 cluster는 빈 cache에서 시작하므로 soft boundary는 cluster마다
+    // cache를 비운 상태로 다시 시뮬레이션해서 정한다
+    std::vector<size_t> clusters;
+    FifoCache cache(vertices.size(), cacheSize);
+    for (size_t h = 0; h + 1 < hardBoundaries.size(); h++) {
+        size_t begin = hardBoundaries[h];
+        size_t end = hardBoundaries[h + 1];
+        size_t clusterMisses = 0;
+        for (size_t t = begin; t < end; t++)
+            clusterMisses += triangleMisses[t];
+        float limit = threshold * clusterMisses / (end - begin);
+
+        clusters.push_back(begin);
+        cache.Flush();
+        size_t misses = 0;
+        size_t count = 0;
+        for (size_t t = begin; t < end; t++) {
+            for (uint32_t k = 0; k < 3; k++)
+                misses += cache.Access(indices[t * 3 + k]) ? 1 : 0;
+            count++;
+            // 여기서 끊어도 ACMR이 허용 범위 안이면 새 cluster 시작
+            if (t + 1 < end && (float)misses / count <= limit) {
+                clusters.push_back(t + 1);
+                cache.Flush();
+                misses = 0;
+                count = 0;
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+    size_t clusterCount = clusters.size() - 1;
+
+    // 면적 가중 메쉬 중심
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    std::vector<glm::vec3> triangleCentroids(triangleCount);
+    std::vector<glm::vec3> triangleNormals(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        auto& p0 = vertices[indices[t * 3]].position;
+        auto& p1 = vertices[indices[t * 3 + 1]].position;
+        auto& p2 = vertices[indices[t * 3 + 2]].position;
+        // 외적의 크기 = 면적 * 2 이므로 정규화하지 않은 normal이 곧 면적 가중치
+        auto normal = glm::cross(p1 - p0, p2 - p0);
+        float area = glm::length(normal);
+        triangleCentroids[t] = (p0 + p1 + p2) / 3.0f;
+        triangleNormals[t] = normal;
+        meshCentroid += triangleCentroids[t] * area;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    std::vector<float> sortKeys(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+            float triangleArea = glm::length(triangleNormals[t]);
+            centroid += triangleCentroids[t] * triangleArea;
+            normal += triangleNormals[t];
+            area += triangleArea;
+        }
+        float normalLength = glm::length(normal);
+        if (area > 0.0f && normalLength > 0.0f)
+            sortKeys[c] = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+        else
+            sortKeys[c] = 0.0f;
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (auto c : order) {
+        result.insert(result.end(),
+            indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    }
+    indices.swap(result);
+}
+
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    // index에서 처음 등장하는 순서대로 정점 번호를 다시 매긴다. 사용되지 않는 정점은 제거
+    constexpr uint32_t kUnused = 0xffffffff;
+    std::vector<uint32_t> remap(vertices.size(), kUnused);
+    std::vector<Vertex> result;
+    result.reserve(vertices.size());
+    for (auto& index : indices) {
+        if (remap[index] == kUnused) {
+            remap[index] = (uint32_t)result.size();
+            result.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(result);
+}
+
+std::vector<uint32_t> SimplifyMesh(const std::vector<Vertex>& vertices,
+    const std::vector<uint32_t>& indices, size_t targetIndexCount, float* resultError) {
+    size_t vertexCount = vertices.size();
+    size_t triangleCount = indices.size() / 3;
+
+    // 위치가 같은 정점(wedge)은 하나의 위치 정점으로 묶는다
+    std::vector<uint32_t> positionOf(vertexCount);
+    std::vector<uint32_t> wedgeCount(vertexCount, 0);
+    {
+        std::unordered_map<uint64_t, uint32_t> positionMap;
+        positionMap.reserve(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++) {
+            auto key = HashString(std::string_view((const char*)&vertices[i].position, sizeof(glm::vec3)));
+            auto result = positionMap.emplace(key, (uint32_t)i);
+            // 해시 충돌이면 별개의 위치로 취급 (잠기지 않을 뿐 결과는 올바름)
+            uint32_t representative = result.first->second;
+            if (memcmp(&vertices[representative].position, &vertices[i].position, sizeof(glm::vec3)) != 0)
+                representative = (uint32_t)i;
+            positionOf[i] = representative;
+            wedgeCount[representative]++;
+        }
+    }
+
+    // 위치 기준으로 한 삼각형에만 속한 edge는 경계. 경계 위의 정점은 고정
+    std::vector<uint8_t> locked(vertexCount, 0);
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeCount;
+        edgeCount.reserve(indices.size());
+        for (size_t t = 0; t < triangleCount; t++) {
+            for (uint32_t k = 0; k < 3; k++) {
+                uint32_t a = positionOf[indices[t * 3 + k]];
+                uint32_t b = positionOf[indices[t * 3 + (k + 1) % 3]];
+                edgeCount[(uint64_t)std::min(a, b) << 32 | std::max(a, b)]++;
+            }
+        }
+        for (auto& edge : edgeCount) {
+            if (edge.second == 1) {
+                locked[edge.first >> 32] = 1;
+                locked[edge.first & 0xffffffff] = 1;
+            }
+        }
+        for (size_t i = 0; i < vertexCount; i++) {
+            if (locked[positionOf[i]] || wedgeCount[positionOf[i]] > 1)
+                locked[i] = 1;
+        }
+    }
+
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        auto& p0 = vertices[indices[t * 3]].position;
+        auto& p1 = vertices[indices[t * 3 + 1]].position;
+        auto& p2 = vertices[indices[t * 3 + 2]].position;
+        auto normal = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normal /= length;
+            auto quadric = Quadric::FromPlane(normal.x, normal.y, normal.z,
+                -glm::dot(normal, p0), length * 0.5f);
+            for (uint32_t k = 0; k < 3; k++)
+                quadrics[positionOf[indices[t * 3 + k]]].Add(quadric);
+        }
+        for (uint32_t k = 0; k < 3; k++)
+            vertexTriangles[indices[t * 3 + k]].push_back((uint32_t)t);
+    }
+
+    std::vector<uint32_t> result(indices);
+    std::vector<uint8_t> triangleRemoved(triangleCount, 0);
+    std::vector<uint8_t> vertexRemoved(vertexCount, 0);
+    std::vector<uint32_t> versions(vertexCount, 0);
+
+    struct Collapse {
+        double cost;
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+    // from은 움직일 수 있어야 하고, to는 wedge가 하나여야 from의 삼각형을 그대로 넘겨받을 수 있다
+    auto pushCollapse = [&](uint32_t from, uint32_t to) {
+        if (locked[from] || wedgeCount[positionOf[to]] != 1)
+            return;
+        Quadric quadric = quadrics[from];
+        quadric.Add(quadrics[positionOf[to]]);
+        queue.push({ quadric.Evaluate(vertices[to].position), from, to, versions[from], versions[to] });
+    };
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (uint32_t k = 0; k < 3; k++) {
+            uint32_t a = indices[t * 3 + k];
+            uint32_t b = indices[t * 3 + (k + 1) % 3];
+            pushCollapse(a, b);
+            pushCollapse(b, a);
+        }
+    }
+
+    size_t liveTriangleCount = triangleCount;
+    double maxError = 0.0;
+    std::vector<uint32_t> fromNeighbors;
+    std::vector<uint32_t> toNeighbors;
+    while (liveTriangleCount * 3 > targetIndexCount && !queue.empty()) {
+        auto collapse = queue.top();
+        queue.pop();
+        uint32_t from = collapse.from;
+        uint32_t to = collapse.to;
+        if (vertexRemoved[from] || vertexRemoved[to] ||
+            versions[from] != collapse.fromVersion || versions[to] != collapse.toVersion)
+            continue;
+
+        // edge가 아직 존재하는지, 합친 뒤 뒤집히는 삼각형이 없는지 검사
+        bool flipped = false;
+        uint32_t sharedTriangleCount = 0;
+        auto& target = vertices[to].position;
+        for (auto t : vertexTriangles[from]) {
+            if (triangleRemoved[t])
+                continue;
+            uint32_t* triangle = &result[t * 3];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                sharedTriangleCount++;
+                continue;
+            }
+            glm::vec3 before[3], after[3];
+            for (uint32_t k = 0; k < 3; k++) {
+                before[k] = vertices[triangle[k]].position;
+                after[k] = triangle[k] == from ? target : before[k];
+            }
+            auto normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+            auto normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+            if (glm::dot(normalBefore, normalAfter) <= 0.0f) {
+                flipped = true;
+                break;
+            }
+        }
+        bool connected = sharedTriangleCount > 0;
+        if (!connected || flipped)
+            continue;
+
+        /*
+            link condition: from과 to에 모두 이웃한 정점은 edge를 공유하는 삼각형의 세번째 정점뿐이어야 한다
+            다른 공통 이웃이 있으면 합친 뒤 같은 edge를 세 개 이상의 삼각형이 공유하거나
+            (non-manifold) 같은 삼각형이 겹쳐 생긴다. 이웃은 위치 기준으로 비교
+        */
+        auto gatherNeighbors = [&](uint32_t vertex, std::vector<uint32_t>& neighbors) {
+            neighbors.clear();
+            for (auto t : vertexTriangles[vertex]) {
+                if (triangleRemoved[t])
+                    continue;
+                for (uint32_t k = 0; k < 3; k++) {
+                    uint32_t other = result[t * 3 + k];
+                    if (other == from || other == to)
+                        continue;
+                    if (std::find(neighbors.begin(), neighbors.end(), positionOf[other]) == neighbors.end())
+                        neighbors.push_back(positionOf[other]);
+                }
+            }
+        };
+        gatherNeighbors(from, fromNeighbors);
+        gatherNeighbors(to, toNeighbors);
+        uint32_t commonCount = 0;
+        for (auto neighbor : fromNeighbors)
+            commonCount += std::find(toNeighbors.begin(), toNeighbors.end(), neighbor) != toNeighbors.end() ? 1 : 0;
+        if (commonCount > sharedTriangleCount)
+            continue;
+
+        for (auto t : vertexTriangles[from]) {
+            if (triangleRemoved[t])
+                continue;
+            uint32_t* triangle = &result[t * 3];
+            if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                triangleRemoved[t] = 1;
+                liveTriangleCount--;
+                continue;
+            }
+            for (uint32_t k = 0; k < 3; k++) {
+                if (triangle[k] == from)
+                    triangle[k] = to;
+            }
+            vertexTriangles[to].push_back(t);
+        }
+        vertexRemoved[from] = 1;
+        quadrics[positionOf[to]].Add(quadrics[from]);
+        versions[to]++;
+        maxError = std::max(maxError, collapse.cost / std::max(quadrics[positionOf[to]].weight, 1e-12));
+
+        // 주변 edge의 비용이 바뀌었으므로 다시 등록
+        for (auto t : vertexTriangles[to]) {
+            if (triangleRemoved[t])
+                continue;
+            for (uint32_t k = 0; k < 3; k++) {
+                uint32_t other = result[t * 3 + k];
+                if (other == to)
+                    continue;
+                pushCollapse(to, other);
+                pushCollapse(other, to);
+            }
+        }
+    }
+
+    std::vector<uint32_t> simplified;
+    simplified.reserve(liveTriangleCount * 3);
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (!triangleRemoved[t])
+            simplified.insert(simplified.end(), result.begin() + t * 3, result.begin() + t * 3 + 3);
+    }
+    if (resultError)
+        *resultError = (float)std::sqrt(std::max(maxError, 0.0));
+    return simplified;
+}
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+    uint32_t cacheSize) {
+    VertexCacheStats stats;
+    FifoCache cache(vertexCount, cacheSize);
+    for (auto index : indices)
+        stats.transformCount += cache.Access(index) ? 1 : 0;
+    if (!indices.empty())
+        stats.acmr = (float)stats.transformCount / (indices.size() / 3);
+    if (vertexCount > 0)
+        stats.atvr = (float)stats.transformCount / vertexCount;
+    return stats;
+}
+
+OverdrawStats AnalyzeOverdraw(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+    uint32_t resolution) {
+    OverdrawStats stats;
+    if (indices.empty() || vertices.empty() || resolution == 0)
+        return stats;
+
+    // bounding box의 가장 긴 변이 [0, 1]이 되도록 정규화
+    glm::vec3 minPosition = vertices[0].position;
+    glm::vec3 maxPosition = vertices[0].position;
+    for (auto& vertex : vertices) {
+        minPosition = glm::min(minPosition, vertex.position);
+        maxPosition = glm::max(maxPosition, vertex.position);
+    }
+    glm::vec3 extent = maxPosition - minPosition;
+    float scale = std::max(extent.x, std::max(extent.y, extent.z));
+    scale = scale > 0.0f ? 1.0f / scale : 0.0f;
+
+    std::vector<float> depthBuffer(resolution * resolution);
+    std::vector<glm::vec3> screen(vertices.size());
+    float size = (float)resolution;
+    for (int axis = 0; axis < 3; axis++) {
+        for (float direction : { 1.0f, -1.0f }) {
+            // 카메라는 axis 축의 -direction 쪽에서 +direction 방향을 본다. depth가 작을수록 가까움
+            for (size_t i = 0; i < vertices.size(); i++) {
+                glm::vec3 p = (vertices[i].position - minPosition) * scale;
+                float depth = direction > 0.0f ? p[axis] : 1.0f - p[axis];
+                screen[i] = glm::vec3(p[(axis + 1) % 3] * size, p[(axis + 2) % 3] * size, depth);
+            }
+            std::fill(depthBuffer.begin(), depthBuffer.end(), std::numeric_limits<float>::max());
+
+            for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+                auto& p0 = vertices[indices[t]].position;
+                auto& p1 = vertices[indices[t + 1]].position;
+                auto& p2 = vertices[indices[t + 2]].position;
+                // 카메라를 향하지 않는 면 제거
+                if (glm::cross(p1 - p0, p2 - p0)[axis] * direction >= 0.0f)
+                    continue;
+                stats.triangleCount++;
+
+                glm::vec3 a = screen[indices[t]];
+                glm::vec3 b = screen[indices[t + 1]];
+                glm::vec3 c = screen[indices[t + 2]];
+                float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+                if (area == 0.0f)
+                    continue;
+                // 투영 방향에 따라 화면상의 winding이 바뀌므로 항상 양수 면적이 되도록 정렬
+                if (area < 0.0f) {
+                    std::swap(b, c);
+                    area = -area;
+                }
+                int minX = std::max((int)std::floor(std::min(a.x, std::min(b.x, c.x))), 0);
+                int minY = std::max((int)std::floor(std::min(a.y, std::min(b.y, c.y))), 0);
+                int maxX = std::min((int)std::ceil(std::max(a.x, std::max(b.x, c.x))), (int)resolution - 1);
+                int maxY = std::min((int)std::ceil(std::max(a.y, std::max(b.y, c.y))), (int)resolution - 1);
+                for (int y = minY; y <= maxY; y++) {
+                    for (int x = minX; x <= maxX; x++) {
+                        // 픽셀 중심의 barycentric 좌표
+                        float px = x + 0.5f, py = y + 0.5f;
+                        float w0 = (c.x - b.x) * (py - b.y) - (c.y - b.y) * (px - b.x);
+                        float w1 = (a.x - c.x) * (py - c.y) - (a.y - c.y) * (px - c.x);
+                        float w2 = (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+                        if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+                            continue;
+                        float depth = (w0 * a.z + w1 * b.z + w2 * c.z) / area;
+                        float& stored = depthBuffer[y * resolution + x];
+                        if (depth < stored) {
+                            stored = depth;
+                            stats.pixelsShaded++;
+                        }
+                    }
+                }
+            }
+            for (float depth : depthBuffer)
+                stats.pixelsCovered += depth != std::numeric_limits<float>::max() ? 1 : 0;
+        }
+    }
+    if (stats.pixelsCovered > 0)
+        stats.overdraw = (float)stats.pixelsShaded / stats.pixelsCovered;
+    return stats;
+}
+
+} // namespace MeshOptimizer
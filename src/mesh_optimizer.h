@@ -0,0 +1,70 @@
+#ifndef __MESH_OPTIMIZER_H__
+#define __MESH_OPTIMIZER_H__
+
+#include "common.h"
+#include <vector>
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+};
+
+// post-transform vertex cache 시뮬레이션 결과
+struct VertexCacheStats {
+    size_t transformCount { 0 }; // cache miss로 vertex shader가 실행된 횟수
+    float acmr { 0.0f };         // 삼각형당 평균 cache miss 수 (0.5 ~ 3)
+    float atvr { 0.0f };         // 정점당 평균 vertex shader 실행 수 (1이 최적)
+};
+
+// 소프트웨어 rasterizer로 측정한 overdraw
+struct OverdrawStats {
+    size_t pixelsCovered { 0 }; // 최종적으로 메쉬가 덮은 픽셀 수
+    size_t pixelsShaded { 0 };  // depth test를 통과하여 fragment shader가 실행된 횟수
+    size_t triangleCount { 0 }; // 모든 방향에서 rasterize한 (앞면) 삼각형 수
+    float overdraw { 0.0f };    // pixelsShaded / pixelsCovered (1이 최적)
+};
+
+/*
+    mesh import 시 사용하는 최적화 단계들. 보통 아래 순서로 적용한다
+    1. DeduplicateVertices: 완전히 같은 정점을 하나로 합침
+    2. OptimizeVertexCache: post-transform cache 적중률이 높도록 삼각형 순서 변경 (Tipsify)
+    3. OptimizeOverdraw: cache 효율을 유지하는 cluster 단위로 바깥쪽을 향한 면부터 그리도록 정렬
+    4. OptimizeVertexFetch: 정점을 index에서 처음 사용되는 순서로 재배치 (pre-transform cache)
+    LOD는 최적화가 끝난 정점 배열을 공유하고 SimplifyMesh로 index만 새로 만든다
+*/
+namespace MeshOptimizer {
+
+// GPU의 post-transform cache 크기 추정값. FIFO로 시뮬레이션 한다
+constexpr uint32_t kVertexCacheSize = 16;
+
+void DeduplicateVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount,
+    uint32_t cacheSize = kVertexCacheSize);
+// threshold: cache miss 증가를 얼마나 허용할지 (1.05 = 5%)
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+    float threshold = 1.05f, uint32_t cacheSize = kVertexCacheSize);
+void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+/*
+    quadric error metric 기반 edge collapse (half-edge, 정점은 기존 정점 중 하나로 합쳐짐)
+    삼각형 수가 targetIndexCount / 3 이하가 되거나 더 줄일 수 없을 때까지 진행하고
+    새 index 배열을 돌려준다. 정점 배열은 바꾸지 않으므로 원래 vertex buffer를 공유할 수 있다
+    경계(열린 edge) 위의 정점과 UV / normal seam 위의 정점은 모양 유지를 위해 움직이지 않는다
+    면이 뒤집히거나 link condition을 어겨 non-manifold가 되는 collapse는 건너뛴다
+    resultError: 수행한 collapse 중 가장 큰 오차 (메쉬 단위의 거리)
+*/
+std::vector<uint32_t> SimplifyMesh(const std::vector<Vertex>& vertices,
+    const std::vector<uint32_t>& indices, size_t targetIndexCount,
+    float* resultError = nullptr);
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+    uint32_t cacheSize = kVertexCacheSize);
+// 메쉬를 bounding box에 맞춰 6개 축 방향(+-x, +-y, +-z)에서 직교 투영으로 그리며
+// 뒷면 제거와 depth test(less)를 거친 overdraw를 센다. resolution: 방향별 depth buffer 크기
+OverdrawStats AnalyzeOverdraw(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+    uint32_t resolution = 256);
+
+} // namespace MeshOptimizer
+
+#endif // __MESH_OPTIMIZER_H__
@@ -0,0 +1,122 @@
+#include "mesh_storage.h"
+#include "mesh_optimizer.h"
+#include "render_state.h"
+
+MeshStorageUPtr MeshStorage::Create(size_t blockSize) {
+    auto storage = MeshStorageUPtr(new MeshStorage());
+    storage->Init(blockSize);
+    return std::move(storage);
+}
+
+void MeshStorage::Init(size_t blockSize) {
+    m_vertexArena = BufferArena::Create(GL_STATIC_DRAW, blockSize);
+    m_indexArena = BufferArena::Create(GL_STATIC_DRAW, blockSize);
+}
+
+size_t MeshStorage::GetVertexStride(MeshVertexFormat vertexFormat) {
+    return vertexFormat == MeshVertexFormat::Quantized ? sizeof(PackedVertex) : sizeof(Vertex);
+}
+
+bool MeshStorage::Allocate(MeshVertexFormat vertexFormat, const void* vertexData, uint32_t vertexCount,
+    const void* indexData, size_t indexDataSize, MeshRange& range) {
+    size_t stride = GetVertexStride(vertexFormat);
+    size_t vertexDataSize = stride * vertexCount;
+    range.vertices = m_vertexArena->Allocate(vertexDataSize, stride);
+    range.indices = m_indexArena->Allocate(indexDataSize, sizeof(uint32_t));
+    if (range.vertices == BufferArena::kInvalidHandle || range.indices == BufferArena::kInvalidHandle ||
+        !m_vertexArena->Upload(range.vertices, vertexData, vertexDataSize) ||
+        !m_indexArena->Upload(range.indices, indexData, indexDataSize)) {
+        SPDLOG_ERROR("failed to allocate mesh storage: {} vertices, {} index bytes", vertexCount, indexDataSize);
+        Free(range);
+        return false;
+    }
+
+    range.vertexFormat = vertexFormat;
+    range.vertexLayout = GetVertexLayout(vertexFormat,
+        m_vertexArena->GetAllocation(range.vertices).block,
+        m_indexArena->GetAllocation(range.indices).block);
+    return true;
+}
+
+void MeshStorage::Free(MeshRange& range) {
+    // Allocate 실패로 되돌리는 중에도 불리므로 유효한 handle만 해제
+    bool freed = range.vertices != BufferArena::kInvalidHandle || range.indices != BufferArena::kInvalidHandle;
+    m_vertexArena->Free(range.vertices);
+    m_indexArena->Free(range.indices);
+    range = MeshRange();
+    if (freed && (NeedsDefragment(m_vertexArena.get()) || NeedsDefragment(m_indexArena.get())))
+        Defragment();
+}
+
+void MeshStorage::Defragment() {
+    m_vertexArena->Defragment();
+    m_indexArena->Defragment();
+    m_defragmentCount++;
+}
+
+int32_t MeshStorage::GetBaseVertex(const MeshRange& range) const {
+    // 정점 구간은 stride로 정렬되어 있고 Defragment도 정렬을 유지한다
+    return (int32_t)(m_vertexArena->GetAllocation(range.vertices).offset / GetVertexStride(range.vertexFormat));
+}
+
+uint32_t MeshStorage::GetIndexOffset(const MeshRange& range) const {
+    return (uint32_t)m_indexArena->GetAllocation(range.indices).offset;
+}
+
+float MeshStorage::GetFragmentation(const BufferArena::Stats& stats) {
+    size_t freeSize = stats.capacity - stats.usedSize;
+    if (freeSize == 0)
+        return 0.0f;
+    return (float)stats.holeSize / (float)freeSize;
+}
+
+bool MeshStorage::NeedsDefragment(const BufferArena* arena) {
+    // block 끝에 남는 free 구간은 이어서 할당할 수 있으므로 중간의 구멍만 단편화로 본다
+    auto stats = arena->GetStats();
+    return stats.holeSize >= (size_t)(stats.capacity * kDefragmentMinHoleRatio) &&
+        GetFragmentation(stats) > kDefragmentThreshold;
+}
+
+void MeshStorage::SetInstanceAttribs(uint32_t first, uint32_t last) {
+    m_instanceAttribFirst = first;
+    m_instanceAttribLast = last;
+    for (auto& layout : m_vertexLayouts) {
+        for (uint32_t i = first; i <= last; i++)
+            layout.vertexLayout->SetAttribDivisor(i, 1);
+    }
+}
+
+const VertexLayout* MeshStorage::GetVertexLayout(MeshVertexFormat vertexFormat,
+    uint32_t vertexBlock, uint32_t indexBlock) {
+    for (auto& layout : m_vertexLayouts) {
+        if (layout.vertexFormat == vertexFormat && layout.vertexBlock == vertexBlock &&
+            layout.indexBlock == indexBlock)
+            return layout.vertexLayout.get();
+    }
+
+    /*
+        ※ 순서 주의
+        vertex attribute을 설정하기 전에 VBO가 바인딩 되어있을 것
+        EBO 바인딩은 VAO에 기록되므로 VAO를 먼저 바인딩
+    */
+    auto vertexLayout = VertexLayout::Create();
+    auto& renderState = RenderState::Get();
+    renderState.BindBuffer(GL_ARRAY_BUFFER, m_vertexArena->GetBuffer(vertexBlock)->Get());
+    if (vertexFormat == MeshVertexFormat::Quantized) {
+        // 정수 attribute를 normalized로 지정하면 [-1, 1] float으로 변환되어 shader에 전달된다
+        vertexLayout->SetAttrib(0, 3, GL_SHORT, true, sizeof(PackedVertex), offsetof(PackedVertex, position));
+        vertexLayout->SetAttrib(1, 2, GL_SHORT, true, sizeof(PackedVertex), offsetof(PackedVertex, normal));
+        vertexLayout->SetAttrib(2, 2, GL_HALF_FLOAT, false, sizeof(PackedVertex), offsetof(PackedVertex, texCoord));
+    }
+    else {
+        vertexLayout->SetAttrib(0, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, position));
+        vertexLayout->SetAttrib(1, 3, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, normal));
+        vertexLayout->SetAttrib(2, 2, GL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, texCoord));
+    }
+    renderState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexArena->GetBuffer(indexBlock)->Get());
+    for (uint32_t i = m_instanceAttribFirst; i <= m_instanceAttribLast; i++)
+        vertexLayout->SetAttribDivisor(i, 1);
+
+    m_vertexLayouts.push_back({ vertexFormat, vertexBlock, indexBlock, std::move(vertexLayout) });
+    return m_vertexLayouts.back().vertexLayout.get();
+}
@@ -0,0 +1,83 @@
+#ifndef __MESH_STORAGE_H__
+#define __MESH_STORAGE_H__
+
+#include "buffer_arena.h"
+#include "vertex_layout.h"
+#include "mesh_file.h"
+
+// storage 안에서 메쉬 하나가 차지하는 정점 / 인덱스 구간
+// offset은 Defragment로 바뀔 수 있으므로 handle만 들고 그릴 때 storage에서 조회한다
+struct MeshRange {
+    BufferArena::Handle vertices { BufferArena::kInvalidHandle };
+    BufferArena::Handle indices { BufferArena::kInvalidHandle };
+    MeshVertexFormat vertexFormat { MeshVertexFormat::Float };
+    // Defragment는 block 안에서만 구간을 옮기므로 VAO는 바뀌지 않는다
+    const VertexLayout* vertexLayout { nullptr };
+};
+
+/*
+    여러 메쉬가 함께 쓰는 정점 / 인덱스 BufferArena와 VAO
+    메쉬마다 버퍼 오브젝트를 만들지 않고 arena에서 구간만 할당받으므로
+    같은 VAO를 바인딩한 채 glDrawElementsBaseVertex로 연달아 그릴 수 있다
+    - 정점 구간은 stride 단위로 정렬하므로 offset / stride가 base vertex
+    - 인덱스 구간은 4byte로 정렬 (16bit / 32bit index가 섞여도 됨)
+    VAO의 attribute / index buffer는 block 하나를 가리키므로
+    (정점 형식, 정점 block, 인덱스 block) 조합마다 VAO를 하나 만든다
+    Free 후 빈 구간이 잘게 나뉘면 arena를 Defragment 한다.
+    구간이 옮겨지면 base vertex / index offset이 바뀌므로 MeshRange에 저장하지 않고
+    GetBaseVertex / GetIndexOffset으로 매번 handle에서 계산한다
+*/
+CLASS_PTR(MeshStorage)
+class MeshStorage {
+public:
+    static MeshStorageUPtr Create(size_t blockSize = 16 * 1024 * 1024);
+    static size_t GetVertexStride(MeshVertexFormat vertexFormat);
+
+    // 데이터를 arena에 올리고 구간을 range에 기록. 실패하면 할당한 구간을 되돌리고 false
+    bool Allocate(MeshVertexFormat vertexFormat, const void* vertexData, uint32_t vertexCount,
+        const void* indexData, size_t indexDataSize, MeshRange& range);
+    // 해제 후 어느 한 arena의 단편화가 기준을 넘으면 Defragment
+    void Free(MeshRange& range);
+    // 살아있는 구간을 block 앞쪽으로 모은다 (GPU 복사)
+    void Defragment();
+    int32_t GetBaseVertex(const MeshRange& range) const;
+    // index block 안의 byte offset
+    uint32_t GetIndexOffset(const MeshRange& range) const;
+    // [first, last] location을 인스턴스마다 갱신하는 attribute로 지정 (divisor 1)
+    // 이미 만든 VAO와 이후에 만드는 VAO 모두에 적용된다
+    void SetInstanceAttribs(uint32_t first, uint32_t last);
+
+    const BufferArena* GetVertexArena() const { return m_vertexArena.get(); }
+    const BufferArena* GetIndexArena() const { return m_indexArena.get(); }
+    size_t GetVertexLayoutCount() const { return m_vertexLayouts.size(); }
+    size_t GetDefragmentCount() const { return m_defragmentCount; }
+
+    // 빈 공간 중 block 중간의 구멍이 차지하는 비율 (0: 단편화 없음)
+    static float GetFragmentation(const BufferArena::Stats& stats);
+    static constexpr float kDefragmentThreshold = 0.5f;
+    // 구멍이 작을 때 block 전체를 복사하지 않도록 capacity 대비 최소 크기
+    static constexpr float kDefragmentMinHoleRatio = 0.125f;
+
+private:
+    MeshStorage() {}
+    void Init(size_t blockSize);
+    static bool NeedsDefragment(const BufferArena* arena);
+    const VertexLayout* GetVertexLayout(MeshVertexFormat vertexFormat,
+        uint32_t vertexBlock, uint32_t indexBlock);
+
+    BufferArenaUPtr m_vertexArena;
+    BufferArenaUPtr m_indexArena;
+    struct Layout {
+        MeshVertexFormat vertexFormat;
+        uint32_t vertexBlock;
+        uint32_t indexBlock;
+        VertexLayoutUPtr vertexLayout;
+    };
+    std::vector<Layout> m_vertexLayouts;
+    // 인스턴스 attribute location 범위. first > last이면 없음
+    uint32_t m_instanceAttribFirst { 1 };
+    uint32_t m_instanceAttribLast { 0 };
+    size_t m_defragmentCount { 0 };
+};
+
+#endif // __MESH_STORAGE_H__
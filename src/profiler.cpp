@@ -0,0 +1,231 @@
+#include "profiler.h"
+#include <atomic>
+#include <fstream>
+
+// 프로파일 이벤트를 기록한 thread 번호. 0번은 처음 기록한 thread (보통 GL thread)
+static uint32_t GetProfileThreadId() {
+    static std::atomic<uint32_t> nextThreadId { 0 };
+    thread_local uint32_t threadId = nextThreadId++;
+    return threadId;
+}
+
+static constexpr uint32_t kInvalidGpuScope = 0xffffffff;
+static constexpr uint32_t kGpuThreadId = 1000;
+
+static const char* GetCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::DrawCall: return "drawCalls";
+        case ProfileCounter::StateChange: return "stateChanges";
+        case ProfileCounter::StateChangeAvoided: return "stateChangesAvoided";
+        case ProfileCounter::UniformUpload: return "uniformUploads";
+        case ProfileCounter::Triangle: return "triangles";
+        case ProfileCounter::StreamBytes: return "streamBytes";
+        case ProfileCounter::FenceWait: return "fenceWaitUs";
+        case ProfileCounter::TextureUploadBytes: return "textureUploadBytes";
+        default: return "unknown";
+    }
+}
+
+Profiler& Profiler::Get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() {
+    m_startTime = std::chrono::steady_clock::now();
+}
+
+double Profiler::Now() const {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+uint32_t Profiler::AcquireQuery(GpuFrame& gpuFrame) {
+    if (gpuFrame.queryCount == gpuFrame.queryPool.size()) {
+        uint32_t query = 0;
+        glGenQueries(1, &query);
+        gpuFrame.queryPool.push_back(query);
+    }
+    return gpuFrame.queryPool[gpuFrame.queryCount++];
+}
+
+void Profiler::BeginFrame() {
+    if (!m_enabled)
+        return;
+
+    // 같은 슬롯을 사용했던 프레임의 GPU 결과를 읽는다 (kGpuFrameCount 프레임 전)
+    size_t slot = m_frameIndex % kGpuFrameCount;
+    ResolveGpuFrame(slot);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_current = Frame();
+        m_current.index = m_frameIndex;
+        m_current.start = Now();
+    }
+    m_inFrame = true;
+
+    auto& gpuFrame = m_gpuFrames[slot];
+    gpuFrame.frameIndex = m_frameIndex;
+    gpuFrame.scopes.clear();
+    gpuFrame.queryCount = 0;
+    gpuFrame.baseQuery = AcquireQuery(gpuFrame);
+    glQueryCounter(gpuFrame.baseQuery, GL_TIMESTAMP);
+    gpuFrame.pending = true;
+}
+
+void Profiler::EndFrame() {
+    if (!m_enabled || !m_inFrame)
+        return;
+    m_inFrame = false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_current.cpuTime = Now() - m_current.start;
+    m_history.push_back(std::move(m_current));
+    while (m_history.size() > m_historySize)
+        m_history.pop_front();
+    m_frameIndex++;
+}
+
+void Profiler::AddCpuEvent(const char* name, double start, double duration) {
+    if (!m_enabled)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_current.events.push_back({ name, GetProfileThreadId(), false, start, duration });
+}
+
+uint32_t Profiler::BeginGpuScope(const char* name) {
+    if (!m_enabled || !m_inFrame)
+        return kInvalidGpuScope;
+    auto& gpuFrame = m_gpuFrames[m_frameIndex % kGpuFrameCount];
+    // GL_TIME_ELAPSED 쿼리는 중첩할 수 없으므로 timestamp 쌍으로 측정
+    GpuScope scope = { name, AcquireQuery(gpuFrame), 0 };
+    glQueryCounter(scope.beginQuery, GL_TIMESTAMP);
+    gpuFrame.scopes.push_back(scope);
+    return (uint32_t)gpuFrame.scopes.size() - 1;
+}
+
+void Profiler::EndGpuScope(uint32_t scope) {
+    if (scope == kInvalidGpuScope || !m_inFrame)
+        return;
+    auto& gpuFrame = m_gpuFrames[m_frameIndex % kGpuFrameCount];
+    if (scope >= gpuFrame.scopes.size())
+        return;
+    gpuFrame.scopes[scope].endQuery = AcquireQuery(gpuFrame);
+    glQueryCounter(gpuFrame.scopes[scope].endQuery, GL_TIMESTAMP);
+}
+
+Profiler::Frame* Profiler::FindFrame(uint64_t index) {
+    for (auto it = m_history.rbegin(); it != m_history.rend(); ++it) {
+        if (it->index == index)
+            return &(*it);
+    }
+    return nullptr;
+}
+
+void Profiler::ResolveGpuFrame(size_t slot) {
+    auto& gpuFrame = m_gpuFrames[slot];
+    if (!gpuFrame.pending)
+        return;
+    gpuFrame.pending = false;
+
+    // 마지막 쿼리가 준비되었으면 그 이전 쿼리도 모두 준비된 상태
+    // 아직 준비되지 않았다면 기다리지 않고 이 프레임의 GPU 기록은 버린다
+    int available = 0;
+    uint32_t lastQuery = gpuFrame.queryPool[gpuFrame.queryCount - 1];
+    glGetQueryObjectiv(lastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return;
+
+    uint64_t base = 0;
+    glGetQueryObjectui64v(gpuFrame.baseQuery, GL_QUERY_RESULT, &base);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto frame = FindFrame(gpuFrame.frameIndex);
+    if (!frame)
+        return;
+    uint64_t last = base;
+    for (auto& scope : gpuFrame.scopes) {
+        if (!scope.endQuery)
+            continue;
+        uint64_t begin = 0, end = 0;
+        glGetQueryObjectui64v(scope.beginQuery, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &end);
+        frame->events.push_back({ scope.name, kGpuThreadId, true,
+            frame->start + (begin - base) / 1e6, (end - begin) / 1e6 });
+        last = std::max(last, end);
+    }
+    frame->gpuTime = (last - base) / 1e6;
+}
+
+bool Profiler::SaveJson(const std::string& filename) const {
+    std::ofstream fout(filename);
+    if (!fout.is_open()) {
+        SPDLOG_ERROR("failed to open file: {}", filename);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    fout << "{\"frames\":[";
+    for (size_t i = 0; i < m_history.size(); i++) {
+        auto& frame = m_history[i];
+        fout << (i ? "," : "") << fmt::format(
+            "\n{{\"index\":{},\"start\":{:.4f},\"cpuTime\":{:.4f},\"gpuTime\":{:.4f}",
+            frame.index, frame.start, frame.cpuTime, frame.gpuTime);
+        for (size_t c = 0; c < frame.counters.size(); c++)
+            fout << fmt::format(",\"{}\":{}", GetCounterName((ProfileCounter)c), frame.counters[c]);
+        fout << ",\"events\":[";
+        for (size_t e = 0; e < frame.events.size(); e++) {
+            auto& event = frame.events[e];
+            fout << (e ? "," : "") << fmt::format(
+                "{{\"name\":\"{}\",\"thread\":{},\"gpu\":{},\"start\":{:.4f},\"duration\":{:.4f}}}",
+                event.name, event.threadId, event.gpu, event.start, event.duration);
+        }
+        fout << "]}";
+    }
+    fout << "\n]}\n";
+    return true;
+}
+
+bool Profiler::SaveChromeTrace(const std::string& filename) const {
+    std::ofstream fout(filename);
+    if (!fout.is_open()) {
+        SPDLOG_ERROR("failed to open file: {}", filename);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // chrome trace의 시간 단위는 us
+    fout << "{\"traceEvents\":[";
+    fout << fmt::format("\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"GPU\"}}}}",
+        kGpuThreadId);
+    for (auto& frame : m_history) {
+        fout << fmt::format(",\n{{\"name\":\"Frame {}\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{:.3f},\"dur\":{:.3f}}}",
+            frame.index, frame.start * 1000.0, frame.cpuTime * 1000.0);
+        for (auto& event : frame.events) {
+            fout << fmt::format(",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                event.name, event.threadId, event.start * 1000.0, event.duration * 1000.0);
+        }
+        for (size_t c = 0; c < frame.counters.size(); c++) {
+            fout << fmt::format(",\n{{\"name\":\"{}\",\"ph\":\"C\",\"pid\":0,\"ts\":{:.3f},\"args\":{{\"value\":{}}}}}",
+                GetCounterName((ProfileCounter)c), frame.start * 1000.0, frame.counters[c]);
+        }
+    }
+    fout << "\n]}\n";
+    return true;
+}
+
+ProfileScope::ProfileScope(const char* name) : m_name(name) {
+    m_start = Profiler::Get().Now();
+}
+
+ProfileScope::~ProfileScope() {
+    auto& profiler = Profiler::Get();
+    profiler.AddCpuEvent(m_name, m_start, profiler.Now() - m_start);
+}
+
+GpuProfileScope::GpuProfileScope(const char* name) {
+    m_scope = Profiler::Get().BeginGpuScope(name);
+}
+
+GpuProfileScope::~GpuProfileScope() {
+    Profiler::Get().EndGpuScope(m_scope);
+}
@@ -0,0 +1,126 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "common.h"
+#include <array>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+enum class ProfileCounter {
+    DrawCall,
+    StateChange,
+    StateChangeAvoided,
+    UniformUpload,
+    Triangle,
+    StreamBytes,        // StreamBuffer에 쓴 byte
+    FenceWait,          // StreamBuffer가 fence를 기다린 시간 (us)
+    TextureUploadBytes, // TextureStreamer가 올린 텍스처 byte
+    Count,
+};
+
+/*
+    프레임 단위 프로파일러
+    - CPU: ProfileScope(RAII)로 구간 시간 측정. worker thread에서도 사용 가능
+    - GPU: GL_TIMESTAMP 쿼리 쌍으로 구간 시간 측정. 결과는 몇 프레임 뒤에
+      GL_QUERY_RESULT_AVAILABLE 일 때만 읽으므로 파이프라인을 멈추지 않는다
+    - draw call / state change / uniform upload / 삼각형 수 / 스트리밍 byte / fence 대기 카운터
+    최근 프레임 기록을 JSON 또는 Chrome trace(chrome://tracing) 형식으로 저장할 수 있다
+*/
+class Profiler {
+public:
+    static Profiler& Get();
+
+    struct Event {
+        const char* name;
+        uint32_t threadId;
+        bool gpu;
+        double start;    // ms, 프로파일러 시작 기준
+        double duration; // ms
+    };
+
+    struct Frame {
+        uint64_t index { 0 };
+        double start { 0.0 };
+        double cpuTime { 0.0 };
+        double gpuTime { 0.0 };
+        std::array<uint64_t, (size_t)ProfileCounter::Count> counters {};
+        std::vector<Event> events;
+    };
+
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+    void SetHistorySize(size_t size) { m_historySize = size; }
+
+    // GL thread의 메인 루프에서 프레임 시작 / 끝에 호출
+    void BeginFrame();
+    void EndFrame();
+
+    double Now() const;
+    void AddCpuEvent(const char* name, double start, double duration);
+    uint32_t BeginGpuScope(const char* name);
+    void EndGpuScope(uint32_t scope);
+    void AddCounter(ProfileCounter counter, uint64_t value = 1) {
+        m_current.counters[(size_t)counter] += value;
+    }
+
+    const std::deque<Frame>& GetHistory() const { return m_history; }
+    bool SaveJson(const std::string& filename) const;
+    bool SaveChromeTrace(const std::string& filename) const;
+
+private:
+    Profiler();
+    void ResolveGpuFrame(size_t slot);
+    Frame* FindFrame(uint64_t index);
+
+    static constexpr size_t kGpuFrameCount = 3;
+    struct GpuScope {
+        const char* name;
+        uint32_t beginQuery;
+        uint32_t endQuery;
+    };
+    struct GpuFrame {
+        uint64_t frameIndex { 0 };
+        bool pending { false };
+        uint32_t baseQuery { 0 };
+        std::vector<GpuScope> scopes;
+        std::vector<uint32_t> queryPool;
+        size_t queryCount { 0 };
+    };
+    uint32_t AcquireQuery(GpuFrame& gpuFrame);
+
+    bool m_enabled { true };
+    bool m_inFrame { false };
+    uint64_t m_frameIndex { 0 };
+    size_t m_historySize { 300 };
+    Frame m_current;
+    std::deque<Frame> m_history;
+    std::array<GpuFrame, kGpuFrameCount> m_gpuFrames;
+    mutable std::mutex m_mutex;
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+class ProfileScope {
+public:
+    ProfileScope(const char* name);
+    ~ProfileScope();
+private:
+    const char* m_name;
+    double m_start;
+};
+
+class GpuProfileScope {
+public:
+    GpuProfileScope(const char* name);
+    ~GpuProfileScope();
+private:
+    uint32_t m_scope;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a ## b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+#define PROFILE_COUNTER(counter) Profiler::Get().AddCounter(ProfileCounter::counter)
+
+#endif // __PROFILER_H__
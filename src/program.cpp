@@ -1,44 +1,193 @@
 #include "program.h"
+#include "profiler.h"
+#include "render_state.h"
+#include <algorithm>
 
-ProgramUPtr Program::Create(const std::vector<ShaderPtr>& shaders) {
-    auto program = ProgramUPtr(new Program());
-    if (!program->Link(shaders))
+ProgramUPtr Program::Create(const std::vector<ShaderPtr>& shaders, ProgramCache* cache) {
+    auto program = CreateAsync(shaders, cache);
+    if (!program->Wait())
         return nullptr;
     return std::move(program);
 }
 
+ProgramUPtr Program::CreateAsync(const std::vector<ShaderPtr>& shaders, ProgramCache* cache) {
+    auto program = ProgramUPtr(new Program());
+    program->SubmitLink(shaders, cache);
+    return std::move(program);
+}
+
+bool Program::IsParallelCompileSupported() {
+    return GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile;
+}
+
 Program::~Program() {
     if (m_program) {
+        RenderState::Get().ForgetProgram(m_program);
         glDeleteProgram(m_program);
     }
 }
 
-bool Program::Link(const std::vector<ShaderPtr>& shaders) {
+void Program::SubmitLink(const std::vector<ShaderPtr>& shaders, ProgramCache* cache) {
+    PROFILE_SCOPE("Program::SubmitLink");
     m_program = glCreateProgram();
-    for (auto& shader: shaders)
+    if (cache) {
+        // 적중하면 shader 컴파일 / link를 모두 건너뛴다
+        m_cacheKey = cache->GetKey(shaders);
+        if (cache->Load(m_cacheKey, m_program)) {
+            ReflectUniforms();
+            m_linked = true;
+            return;
+        }
+        glProgramParameteri(m_program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        m_cache = cache;
+    }
+
+    // 컴파일 결과를 확인하지 않고 바로 link까지 요청. 실패는 Wait()에서 확인한다
+    for (auto& shader: shaders) {
+        shader->SubmitCompile();
         glAttachShader(m_program, shader->Get());
+    }
     glLinkProgram(m_program);
+    m_pendingShaders = shaders;
+    m_pending = true;
+}
+
+bool Program::IsLinkComplete() const {
+    if (!m_pending || !IsParallelCompileSupported())
+        return true;
+    int complete = 0;
+    glGetProgramiv(m_program, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete != 0;
+}
+
+bool Program::Wait() {
+    if (!m_pending)
+        return m_linked;
+    PROFILE_SCOPE("Program::Wait");
+    m_pending = false;
+    auto shaders = std::move(m_pendingShaders);
+
     int success = 0;
     glGetProgramiv(m_program, GL_LINK_STATUS, &success);
     if (!success) {
+        // 컴파일 에러가 원인이면 해당 shader의 에러를 먼저 출력
+        for (auto& shader : shaders)
+            shader->Compile();
         char infoLog[1024];
         glGetProgramInfoLog(m_program, 1024, nullptr, infoLog);
         SPDLOG_ERROR("failed to link program: {}", infoLog);
         return false;
     }
+    if (m_cache)
+        m_cache->Store(m_cacheKey, m_program);
+    ReflectUniforms();
+    m_linked = true;
     return true;
 }
 
+void Program::Swap(Program& other) {
+    std::swap(m_program, other.m_program);
+    std::swap(m_pending, other.m_pending);
+    std::swap(m_linked, other.m_linked);
+    std::swap(m_pendingShaders, other.m_pendingShaders);
+    std::swap(m_cache, other.m_cache);
+    std::swap(m_cacheKey, other.m_cacheKey);
+    std::swap(m_uniforms, other.m_uniforms);
+}
+
+void Program::ReflectUniforms() {
+    /*
+        link된 프로그램의 active uniform 목록을 한번만 조회하여
+        이름 해시 -> location 테이블을 만든다.
+        이후 SetUniform은 문자열 생성이나 glGetUniformLocation 호출이 없음
+    */
+    int uniformCount = 0;
+    int maxNameLength = 0;
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    m_uniforms.clear();
+    m_uniforms.reserve(uniformCount);
+    std::vector<char> name(std::max(maxNameLength, 1));
+    for (int i = 0; i < uniformCount; i++) {
+        int length = 0;
+        int size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(m_program, i, (GLsizei)name.size(),
+            &length, &size, &type, name.data());
+        // uniform block 안의 멤버는 location이 없으므로 -1
+        int32_t location = glGetUniformLocation(m_program, name.data());
+        if (location < 0)
+            continue;
+
+        std::string_view uniformName(name.data(), length);
+        m_uniforms.push_back({ HashString(uniformName), location });
+        // 배열 uniform은 "name[0]"으로 조회되므로 "name"으로도 찾을 수 있게 추가
+        auto bracket = uniformName.find('[');
+        if (bracket != std::string_view::npos)
+            m_uniforms.push_back({ HashString(uniformName.substr(0, bracket)), location });
+    }
+    std::sort(m_uniforms.begin(), m_uniforms.end(),
+        [](const UniformEntry& a, const UniformEntry& b) { return a.hash < b.hash; });
+}
+
+bool Program::SetUniformBlockBinding(std::string_view blockName, uint32_t binding) const {
+    auto blockIndex = glGetUniformBlockIndex(m_program, std::string(blockName).c_str());
+    if (blockIndex == GL_INVALID_INDEX) {
+        SPDLOG_ERROR("failed to find uniform block: {}", blockName);
+        return false;
+    }
+    glUniformBlockBinding(m_program, blockIndex, binding);
+    return true;
+}
+
+UniformHandle Program::GetUniformHandle(std::string_view name) const {
+    return GetUniformHandle(UniformHash(name));
+}
+
+UniformHandle Program::GetUniformHandle(UniformHash hash) const {
+    auto it = std::lower_bound(m_uniforms.begin(), m_uniforms.end(), hash.value,
+        [](const UniformEntry& entry, uint64_t value) { return entry.hash < value; });
+    if (it == m_uniforms.end() || it->hash != hash.value)
+        return {};
+    return { it->location };
+}
+
 void Program::Use() const {
-    glUseProgram(m_program);
+    RenderState::Get().UseProgram(m_program);
+}
+
+void Program::SetUniform(UniformHandle handle, int value) const {
+    PROFILE_COUNTER(UniformUpload);
+    glUniform1i(handle.location, value);
+}
+
+void Program::SetUniform(UniformHandle handle, float value) const {
+    PROFILE_COUNTER(UniformUpload);
+    glUniform1f(handle.location, value);
+}
+
+void Program::SetUniform(UniformHandle handle, const glm::vec2& value) const {
+    PROFILE_COUNTER(UniformUpload);
+    glUniform2fv(handle.location, 1, glm::value_ptr(value));
+}
+
+void Program::SetUniform(UniformHandle handle, const glm::vec3& value) const {
+    PROFILE_COUNTER(UniformUpload);
+    glUniform3fv(handle.location, 1, glm::value_ptr(value));
+}
+
+void Program::SetUniform(UniformHandle handle, const glm::vec4& value) const {
+    PROFILE_COUNTER(UniformUpload);
+    glUniform4fv(handle.location, 1, glm::value_ptr(value));
 }
 
-void Program::SetUniform(const std::string& name, int value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
-    glUniform1i(loc, value);
+void Program::SetUniform(UniformHandle handle, const glm::mat3& value) const {
+    PROFILE_COUNTER(UniformUpload);
+    glUniformMatrix3fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
-void Program::SetUniform(const std::string& name, const glm::mat4& value) const {
-    auto loc = glGetUniformLocation(m_program, name.c_str());
-    glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+void Program::SetUniform(UniformHandle handle, const glm::mat4& value) const {
+    PROFILE_COUNTER(UniformUpload);
+    glUniformMatrix4fv(handle.location, 1, GL_FALSE, glm::value_ptr(value));
 }
\ No newline at end of file
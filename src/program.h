@@ -3,24 +3,89 @@
 
 #include "common.h"
 #include "shader.h"
+#include "program_cache.h"
+
+// Link 후 한번 조회해 둔 uniform location. 매 프레임 재사용한다
+struct UniformHandle {
+    int32_t location { -1 };
+    bool IsValid() const { return location >= 0; }
+};
+
+// 컴파일 타임에 미리 계산해 둘 수 있는 uniform 이름 해시
+// ex) static constexpr UniformHash kTransform { "transform" };
+struct UniformHash {
+    constexpr explicit UniformHash(std::string_view name)
+        : value(HashString(name)) {}
+    uint64_t value;
+};
 
 CLASS_PTR(Program)
 class Program {
 public:
+    // cache가 있으면 저장된 program binary를 먼저 시도하고, 없거나 거부되면 소스에서 link
     static ProgramUPtr Create(
-        const std::vector<ShaderPtr>& shaders);
+        const std::vector<ShaderPtr>& shaders, ProgramCache* cache = nullptr);
+    // 컴파일 / link 요청만 하고 결과는 기다리지 않는다. 사용하기 전에 Wait()을 호출해야 한다
+    static ProgramUPtr CreateAsync(
+        const std::vector<ShaderPtr>& shaders, ProgramCache* cache = nullptr);
+    // KHR / ARB_parallel_shader_compile 지원 여부
+    static bool IsParallelCompileSupported();
 
     ~Program();
     uint32_t Get() const { return m_program; }    
     void Use() const;
 
-    void SetUniform(const std::string& name, int value) const;
-    void SetUniform(const std::string& name, const glm::mat4& value) const;
+    bool IsPending() const { return m_pending; }
+    bool IsLinked() const { return m_linked; }
+    // Wait()을 호출해도 block되지 않는 상태인가. GL_COMPLETION_STATUS로 기다리지 않고 확인하며
+    // parallel shader compile을 지원하지 않으면 알 수 없으므로 항상 true
+    bool IsLinkComplete() const;
+    // link가 끝날 때까지 기다린 뒤 성공 여부를 반환. 이미 끝났으면 바로 반환
+    bool Wait();
+    // 두 program의 GL 객체와 uniform 테이블을 교환 (hot reload 시 교체용)
+    void Swap(Program& other);
+
+    bool SetUniformBlockBinding(std::string_view blockName, uint32_t binding) const;
+
+    UniformHandle GetUniformHandle(std::string_view name) const;
+    UniformHandle GetUniformHandle(UniformHash hash) const;
+
+    void SetUniform(UniformHandle handle, int value) const;
+    void SetUniform(UniformHandle handle, float value) const;
+    void SetUniform(UniformHandle handle, const glm::vec2& value) const;
+    void SetUniform(UniformHandle handle, const glm::vec3& value) const;
+    void SetUniform(UniformHandle handle, const glm::vec4& value) const;
+    void SetUniform(UniformHandle handle, const glm::mat3& value) const;
+    void SetUniform(UniformHandle handle, const glm::mat4& value) const;
+
+    template <typename T>
+    void SetUniform(std::string_view name, const T& value) const {
+        SetUniform(GetUniformHandle(name), value);
+    }
+    template <typename T>
+    void SetUniform(UniformHash hash, const T& value) const {
+        SetUniform(GetUniformHandle(hash), value);
+    }
+
 private:
     Program() {}
-    bool Link(
-        const std::vector<ShaderPtr>& shaders);
+    void SubmitLink(
+        const std::vector<ShaderPtr>& shaders, ProgramCache* cache);
+    void ReflectUniforms();
     uint32_t m_program { 0 };
+    bool m_pending { false };
+    bool m_linked { false };
+    // link가 끝날 때까지 유지할 shader와 binary를 저장할 캐시
+    std::vector<ShaderPtr> m_pendingShaders;
+    ProgramCache* m_cache { nullptr };
+    uint64_t m_cacheKey { 0 };
+
+    // 이름 해시 기준으로 정렬된 active uniform 테이블
+    struct UniformEntry {
+        uint64_t hash;
+        int32_t location;
+    };
+    std::vector<UniformEntry> m_uniforms;
 };
 
-#endif // __PROGRAM_H__
\ No newline at end of file
+#endif // __PROGRAM_H__
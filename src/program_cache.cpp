@@ -0,0 +1,138 @@
+#include "program_cache.h"
+#include "mapped_file.h"
+#include "profiler.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+static constexpr uint32_t kProgramCacheMagic = 0x42475250; // "PRGB"
+static constexpr uint32_t kProgramCacheVersion = 1;
+
+ProgramCacheUPtr ProgramCache::Create(const std::string& directory) {
+    auto cache = ProgramCacheUPtr(new ProgramCache());
+    if (!cache->Init(directory))
+        return nullptr;
+    return std::move(cache);
+}
+
+bool ProgramCache::Init(const std::string& directory) {
+    // GL 4.1 core 이거나 extension이 있어야 하고, binary 포맷이 하나 이상 있어야 한다
+    int formatCount = 0;
+    if (GLAD_GL_VERSION_4_1 || GLAD_GL_ARB_get_program_binary)
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if (formatCount <= 0) {
+        SPDLOG_INFO("program binary is not supported");
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec) {
+        SPDLOG_ERROR("failed to create program cache directory: {}", directory);
+        return false;
+    }
+    m_directory = directory;
+
+    // 같은 소스라도 driver가 다르면 binary를 재사용할 수 없다
+    auto renderer = (const char*)glGetString(GL_RENDERER);
+    auto version = (const char*)glGetString(GL_VERSION);
+    m_driverHash = HashString(renderer ? renderer : "");
+    m_driverHash = HashString(version ? version : "", m_driverHash);
+    return true;
+}
+
+std::string ProgramCache::GetCachePath(uint64_t key) const {
+    return fmt::format("{}/{:016x}.progbin", m_directory, key);
+}
+
+uint64_t ProgramCache::GetKey(const std::vector<ShaderPtr>& shaders) const {
+    // attach 순서와 무관하도록 shader 해시를 정렬해서 섞는다
+    std::vector<uint64_t> hashes;
+    for (auto& shader : shaders)
+        hashes.push_back(shader->GetHash());
+    std::sort(hashes.begin(), hashes.end());
+    return HashString(std::string_view((const char*)hashes.data(),
+        sizeof(uint64_t) * hashes.size()), m_driverHash);
+}
+
+bool ProgramCache::Load(uint64_t key, uint32_t program) {
+    PROFILE_SCOPE("ProgramCache::Load");
+    auto cachePath = GetCachePath(key);
+    std::error_code ec;
+    if (!fs::exists(cachePath, ec)) {
+        m_missCount++;
+        return false;
+    }
+    auto file = MappedFile::Open(cachePath);
+    if (!file || file->GetSize() < sizeof(ProgramCacheHeader)) {
+        m_missCount++;
+        return false;
+    }
+
+    auto header = (const ProgramCacheHeader*)file->GetData();
+    if (header->magic != kProgramCacheMagic ||
+        header->version != kProgramCacheVersion ||
+        header->key != key ||
+        sizeof(ProgramCacheHeader) + header->binarySize > file->GetSize()) {
+        m_missCount++;
+        return false;
+    }
+
+    // driver 업데이트 등으로 binary가 거부되면 link 실패 상태가 된다
+    glProgramBinary(program, header->binaryFormat,
+        file->GetData() + sizeof(ProgramCacheHeader), header->binarySize);
+    int success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        SPDLOG_INFO("program binary rejected, recompile: {}", cachePath);
+        m_missCount++;
+        return false;
+    }
+    m_hitCount++;
+    return true;
+}
+
+bool ProgramCache::Store(uint64_t key, uint32_t program) const {
+    PROFILE_SCOPE("ProgramCache::Store");
+    int binarySize = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize <= 0)
+        return false;
+
+    ProgramCacheHeader header = {};
+    header.magic = kProgramCacheMagic;
+    header.version = kProgramCacheVersion;
+    header.key = key;
+    std::vector<uint8_t> binary(binarySize);
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, binarySize, &binarySize, &binaryFormat, binary.data());
+    header.binaryFormat = binaryFormat;
+    header.binarySize = (uint32_t)binarySize;
+
+    // 쓰는 도중 종료되어도 깨진 파일이 남지 않도록 임시 파일에 쓴 뒤 이름을 바꾼다
+    auto cachePath = GetCachePath(key);
+    auto tempPath = cachePath + ".tmp";
+    {
+        std::ofstream fout(tempPath, std::ios::binary);
+        if (!fout.is_open()) {
+            SPDLOG_ERROR("failed to write program cache: {}", tempPath);
+            return false;
+        }
+        fout.write((const char*)&header, sizeof(header));
+        fout.write((const char*)binary.data(), header.binarySize);
+        if (!fout.good()) {
+            SPDLOG_ERROR("failed to write program cache: {}", tempPath);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        SPDLOG_ERROR("failed to write program cache: {}", cachePath);
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef __PROGRAM_CACHE_H__
+#define __PROGRAM_CACHE_H__
+
+#include "common.h"
+#include "shader.h"
+
+/*
+    link가 끝난 프로그램의 driver binary(glGetProgramBinary)를 저장해두는 디스크 캐시
+    파일 구조: ProgramCacheHeader | binary
+    key: 각 shader 소스의 해시 + GL_RENDERER / GL_VERSION
+    driver가 바뀌거나 binary를 거부하면(glProgramBinary 후 link 실패) 소스에서 다시 컴파일한다
+*/
+struct ProgramCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t binaryFormat;
+    uint32_t binarySize;
+};
+
+CLASS_PTR(ProgramCache)
+class ProgramCache {
+public:
+    // GL_ARB_get_program_binary를 지원하지 않으면 nullptr
+    static ProgramCacheUPtr Create(const std::string& directory = "./cache/program");
+
+    uint64_t GetKey(const std::vector<ShaderPtr>& shaders) const;
+    // 성공하면 program은 link된 상태
+    bool Load(uint64_t key, uint32_t program);
+    bool Store(uint64_t key, uint32_t program) const;
+
+    size_t GetHitCount() const { return m_hitCount; }
+    size_t GetMissCount() const { return m_missCount; }
+
+private:
+    ProgramCache() {}
+    bool Init(const std::string& directory);
+    std::string GetCachePath(uint64_t key) const;
+
+    std::string m_directory;
+    uint64_t m_driverHash { 0 };
+    size_t m_hitCount { 0 };
+    size_t m_missCount { 0 };
+};
+
+#endif // __PROGRAM_CACHE_H__
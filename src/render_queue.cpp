@@ -0,0 +1,147 @@
+#include "render_queue.h"
+#include "render_state.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+RenderQueueUPtr RenderQueue::Create(size_t reserveCount) {
+    auto queue = RenderQueueUPtr(new RenderQueue());
+    queue->Init(reserveCount);
+    return std::move(queue);
+}
+
+void RenderQueue::Init(size_t reserveCount) {
+    m_commands.reserve(reserveCount);
+    m_instances.reserve(reserveCount);
+    m_order.reserve(reserveCount);
+    m_orderTemp.reserve(reserveCount);
+    m_keys.reserve(reserveCount);
+    m_keysTemp.reserve(reserveCount);
+}
+
+uint64_t RenderQueue::MakeKey(RenderPass pass, uint32_t programId,
+    uint32_t materialId, float depth) {
+    depth = glm::clamp(depth, 0.0f, 1.0f);
+    uint32_t depthBits = (uint32_t)((double)depth * 0xffffffffu);
+    // 반투명 물체는 뒤쪽부터 그려야 하므로 depth 순서를 뒤집는다
+    if (pass == RenderPass::Transparent)
+        depthBits = ~depthBits;
+    return ((uint64_t)pass & 0x3) << 62 |
+        ((uint64_t)programId & 0x3ff) << 52 |
+        ((uint64_t)materialId & 0xfffff) << 32 |
+        (uint64_t)depthBits;
+}
+
+uint32_t RenderQueue::MakeMaterialId(const uint32_t* textures, size_t textureCount) {
+    // 같은 텍스처 조합이면 같은 id. 충돌해도 정렬 순서만 달라질 뿐 결과는 같음
+    auto view = std::string_view((const char*)textures, sizeof(uint32_t) * textureCount);
+    return (uint32_t)(HashString(view) & 0xfffff);
+}
+
+uint32_t RenderQueue::AddInstance(const InstanceData& instance) {
+    m_instances.push_back(instance);
+    return (uint32_t)m_instances.size() - 1;
+}
+
+void RenderQueue::Submit(const DrawCommand& command) {
+    m_commands.push_back(command);
+}
+
+void RenderQueue::Sort() {
+    PROFILE_SCOPE("RenderQueue::Sort");
+    size_t count = m_commands.size();
+    m_order.resize(count);
+    m_orderTemp.resize(count);
+    m_keys.resize(count);
+    m_keysTemp.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        m_order[i] = (uint32_t)i;
+        m_keys[i] = m_commands[i].key;
+    }
+
+    // LSD radix sort, 8bit 자리씩 8번. 모든 값이 같은 자리는 건너뛴다
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; i++)
+            histogram[(m_keys[i] >> shift) & 0xff]++;
+        if (count == 0 || histogram[(m_keys[0] >> shift) & 0xff] == count)
+            continue;
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; i++) {
+            size_t dst = histogram[(m_keys[i] >> shift) & 0xff]++;
+            m_keysTemp[dst] = m_keys[i];
+            m_orderTemp[dst] = m_order[i];
+        }
+        m_keys.swap(m_keysTemp);
+        m_order.swap(m_orderTemp);
+    }
+}
+
+void RenderQueue::Execute() const {
+    PROFILE_SCOPE("RenderQueue::Execute");
+    auto& renderState = RenderState::Get();
+    const Program* program = nullptr;
+    for (auto index : m_order) {
+        auto& command = m_commands[index];
+        // 같은 상태가 연속되면 RenderState에서 GL 호출이 생략된다
+        if (command.program != program) {
+            program = command.program;
+            program->Use();
+        }
+        command.vertexLayout->Bind();
+        for (uint32_t unit = 0; unit < DrawCommand::kMaxTextureCount; unit++) {
+            if (command.textures[unit]) {
+                uint32_t target = command.textureTargets[unit] ? command.textureTargets[unit] : GL_TEXTURE_2D;
+                renderState.BindTextureUnit(unit, target, command.textures[unit]);
+            }
+        }
+        if (command.modelUniform.IsValid()) {
+            auto& instance = m_instances[command.instanceIndex];
+            program->SetUniform(command.modelUniform, instance.model);
+            if (command.uvRectUniform.IsValid())
+                program->SetUniform(command.uvRectUniform, instance.uvRect);
+            if (command.layerUniform.IsValid())
+                program->SetUniform(command.layerUniform, instance.layer);
+        }
+
+        if (command.instanceBuffer) {
+            // mat4는 vec4 attribute 4개. 바인딩된 VAO에 현재 instance buffer 위치를 기록
+            renderState.BindBuffer(GL_ARRAY_BUFFER, command.instanceBuffer);
+            uint64_t offset = command.instanceOffset;
+            for (uint32_t i = 0; i < 4; i++) {
+                command.vertexLayout->SetAttrib(DrawCommand::kInstanceAttribLocation + i, 4, GL_FLOAT, false,
+                    sizeof(InstanceData), offset + offsetof(InstanceData, model) + sizeof(glm::vec4) * i);
+            }
+            command.vertexLayout->SetAttrib(DrawCommand::kInstanceUvRectLocation, 4, GL_FLOAT, false,
+                sizeof(InstanceData), offset + offsetof(InstanceData, uvRect));
+            command.vertexLayout->SetAttrib(DrawCommand::kInstanceLayerLocation, 1, GL_FLOAT, false,
+                sizeof(InstanceData), offset + offsetof(InstanceData, layer));
+        }
+
+        auto indexOffset = (const void*)(uintptr_t)command.indexOffset;
+        if (command.instanceCount > 0) {
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.indexCount,
+                command.indexType, indexOffset, command.instanceCount, command.baseVertex);
+        }
+        else {
+            glDrawElementsBaseVertex(GL_TRIANGLES, command.indexCount,
+                command.indexType, indexOffset, command.baseVertex);
+        }
+        PROFILE_COUNTER(DrawCall);
+        Profiler::Get().AddCounter(ProfileCounter::Triangle,
+            (uint64_t)command.indexCount / 3 * std::max(command.instanceCount, 1u));
+    }
+}
+
+void RenderQueue::Clear() {
+    m_commands.clear();
+    m_instances.clear();
+    m_order.clear();
+}
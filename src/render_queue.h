@@ -0,0 +1,95 @@
+#ifndef __RENDER_QUEUE_H__
+#define __RENDER_QUEUE_H__
+
+#include "program.h"
+#include "vertex_layout.h"
+
+/*
+    정렬 가능한 draw command 큐
+    Submit으로 쌓은 명령을 64bit sort key로 radix sort 한 뒤
+    상태 변경이 최소가 되도록 순서대로 실행한다.
+
+    sort key (상위 비트부터)
+    | pass 2bit | program 10bit | material 20bit | depth 32bit |
+    opaque pass는 같은 상태 안에서 앞쪽부터(front-to-back) 그려 early-z로 overdraw를 줄이고
+    transparent pass는 depth를 뒤집어 뒤쪽부터 그린다.
+*/
+enum class RenderPass : uint32_t {
+    Opaque = 0,
+    Transparent = 1,
+    Overlay = 2,
+};
+
+// 물체 하나의 model 행렬과 material이 사용하는 atlas 영역
+// instanced draw에서는 그대로 인스턴스별 attribute로 읽는다
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 uvRect; // xy: uvOffset, zw: uvScale
+    float layer;      // texture array의 layer
+    float padding[3];
+};
+
+struct DrawCommand {
+    static constexpr size_t kMaxTextureCount = 2;
+    // instanced draw의 인스턴스별 attribute location
+    // model 행렬(mat4)은 3 ~ 6, atlas 영역은 7 (uvRect), 8 (layer)
+    static constexpr uint32_t kInstanceAttribLocation = 3;
+    static constexpr uint32_t kInstanceUvRectLocation = 7;
+    static constexpr uint32_t kInstanceLayerLocation = 8;
+
+    uint64_t key;
+    const Program* program;
+    // 물체별 draw에서 instanceIndex의 InstanceData를 설정할 uniform. 없는 uniform은 건너뜀
+    UniformHandle modelUniform;
+    UniformHandle uvRectUniform;
+    UniformHandle layerUniform;
+    const VertexLayout* vertexLayout;
+    uint32_t textures[kMaxTextureCount];
+    uint32_t textureTargets[kMaxTextureCount]; // 0이면 GL_TEXTURE_2D
+    uint32_t indexType;     // GL_UNSIGNED_SHORT / GL_UNSIGNED_INT
+    uint32_t indexCount;
+    uint32_t indexOffset;   // byte offset
+    int32_t baseVertex;
+    uint32_t instanceCount; // 0이면 일반 draw, 아니면 instanced draw
+    // InstanceData 배열이 담긴 버퍼와 byte offset. GL 3.3에는 base instance가 없으므로
+    // 같은 VAO로 여러 구간을 그릴 때는 draw 전에 vertexLayout의 attribute 위치를 다시 지정한다
+    uint32_t instanceBuffer;
+    uint32_t instanceOffset;
+    uint32_t instanceIndex;
+};
+
+CLASS_PTR(RenderQueue)
+class RenderQueue {
+public:
+    static RenderQueueUPtr Create(size_t reserveCount = 1024);
+
+    // depth는 0(가까움) ~ 1(멂) 사이로 정규화된 카메라 거리
+    static uint64_t MakeKey(RenderPass pass, uint32_t programId,
+        uint32_t materialId, float depth);
+    static uint32_t MakeMaterialId(const uint32_t* textures, size_t textureCount);
+
+    // 물체별 draw의 데이터를 저장하고 command의 instanceIndex로 사용할 번호를 돌려준다
+    uint32_t AddInstance(const InstanceData& instance);
+    void Submit(const DrawCommand& command);
+
+    void Sort();
+    void Execute() const;
+    void Clear();
+
+    size_t GetCommandCount() const { return m_commands.size(); }
+    const std::vector<uint32_t>& GetOrder() const { return m_order; }
+
+private:
+    RenderQueue() {}
+    void Init(size_t reserveCount);
+
+    std::vector<DrawCommand> m_commands;
+    std::vector<InstanceData> m_instances;
+    // 정렬 결과 (m_commands의 인덱스)와 radix sort 용 임시 버퍼
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_orderTemp;
+    std::vector<uint64_t> m_keys;
+    std::vector<uint64_t> m_keysTemp;
+};
+
+#endif // __RENDER_QUEUE_H__
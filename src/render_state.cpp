@@ -0,0 +1,176 @@
+#include "render_state.h"
+#include "profiler.h"
+
+RenderState& RenderState::Get() {
+    static RenderState renderState;
+    return renderState;
+}
+
+int RenderState::GetBufferTargetIndex(uint32_t target) {
+    switch (target) {
+        case GL_ARRAY_BUFFER: return 0;
+        case GL_ELEMENT_ARRAY_BUFFER: return 1;
+        case GL_UNIFORM_BUFFER: return 2;
+        case GL_PIXEL_PACK_BUFFER: return 3;
+        case GL_PIXEL_UNPACK_BUFFER: return 4;
+        case GL_COPY_READ_BUFFER: return 5;
+        case GL_COPY_WRITE_BUFFER: return 6;
+        default: return -1;
+    }
+}
+
+int RenderState::GetTextureTargetIndex(uint32_t target) {
+    switch (target) {
+        case GL_TEXTURE_2D: return 0;
+        case GL_TEXTURE_2D_ARRAY: return 1;
+        default: return -1;
+    }
+}
+
+int RenderState::GetCapabilityIndex(uint32_t capability) {
+    switch (capability) {
+        case GL_DEPTH_TEST: return 0;
+        case GL_BLEND: return 1;
+        case GL_CULL_FACE: return 2;
+        case GL_SCISSOR_TEST: return 3;
+        case GL_STENCIL_TEST: return 4;
+        default: return -1;
+    }
+}
+
+bool RenderState::Check(bool changed) {
+    if (changed) {
+        m_stats.issuedCount++;
+        PROFILE_COUNTER(StateChange);
+    }
+    else {
+        m_stats.avoidedCount++;
+        PROFILE_COUNTER(StateChangeAvoided);
+    }
+    return changed;
+}
+
+void RenderState::UseProgram(uint32_t program) {
+    if (!Check(m_program != program))
+        return;
+    m_program = program;
+    glUseProgram(program);
+}
+
+void RenderState::BindVertexArray(uint32_t vertexArray) {
+    if (!Check(m_vertexArray != vertexArray))
+        return;
+    m_vertexArray = vertexArray;
+    glBindVertexArray(vertexArray);
+    // element array buffer 바인딩은 VAO 상태의 일부
+    m_buffers[GetBufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = kUnknown;
+}
+
+void RenderState::BindBuffer(uint32_t target, uint32_t buffer) {
+    int index = GetBufferTargetIndex(target);
+    if (index < 0) {
+        Check(true);
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (!Check(m_buffers[index] != buffer))
+        return;
+    m_buffers[index] = buffer;
+    glBindBuffer(target, buffer);
+}
+
+void RenderState::BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer) {
+    // indexed binding은 추적하지 않지만 일반 바인딩도 함께 바뀌므로 반영
+    Check(true);
+    glBindBufferBase(target, index, buffer);
+    int targetIndex = GetBufferTargetIndex(target);
+    if (targetIndex >= 0)
+        m_buffers[targetIndex] = buffer;
+}
+
+void RenderState::ActiveTexture(uint32_t unit) {
+    if (!Check(m_activeTexture != unit))
+        return;
+    m_activeTexture = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void RenderState::BindTexture(uint32_t target, uint32_t texture) {
+    int index = GetTextureTargetIndex(target);
+    if (m_activeTexture >= kTextureUnitCount || index < 0) {
+        Check(true);
+        glBindTexture(target, texture);
+        return;
+    }
+    auto& bound = m_textures[m_activeTexture][index];
+    if (!Check(bound != texture))
+        return;
+    bound = texture;
+    glBindTexture(target, texture);
+}
+
+void RenderState::BindTextureUnit(uint32_t unit, uint32_t target, uint32_t texture) {
+    // 이미 바인딩되어 있으면 active unit도 바꿀 필요 없음
+    int index = GetTextureTargetIndex(target);
+    if (unit < kTextureUnitCount && index >= 0 && m_textures[unit][index] == texture) {
+        Check(false);
+        return;
+    }
+    ActiveTexture(unit);
+    BindTexture(target, texture);
+}
+
+void RenderState::SetEnabled(uint32_t capability, bool enabled) {
+    int index = GetCapabilityIndex(capability);
+    uint32_t value = enabled ? 1 : 0;
+    if (index >= 0) {
+        if (!Check(m_capabilities[index] != value))
+            return;
+        m_capabilities[index] = value;
+    }
+    else {
+        Check(true);
+    }
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void RenderState::ForgetProgram(uint32_t program) {
+    if (m_program == program)
+        m_program = kUnknown;
+}
+
+void RenderState::ForgetVertexArray(uint32_t vertexArray) {
+    if (m_vertexArray == vertexArray) {
+        m_vertexArray = kUnknown;
+        m_buffers[GetBufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER)] = kUnknown;
+    }
+}
+
+void RenderState::ForgetBuffer(uint32_t buffer) {
+    for (auto& bound : m_buffers) {
+        if (bound == buffer)
+            bound = kUnknown;
+    }
+}
+
+void RenderState::ForgetTexture(uint32_t texture) {
+    for (auto& unit : m_textures) {
+        for (auto& bound : unit) {
+            if (bound == texture)
+                bound = kUnknown;
+        }
+    }
+}
+
+void RenderState::Invalidate() {
+    m_program = kUnknown;
+    m_vertexArray = kUnknown;
+    m_activeTexture = kUnknown;
+    m_buffers.fill(kUnknown);
+    for (auto& unit : m_textures)
+        unit.fill(kUnknown);
+    m_capabilities.fill(kUnknown);
+}
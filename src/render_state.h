@@ -0,0 +1,68 @@
+#ifndef __RENDER_STATE_H__
+#define __RENDER_STATE_H__
+
+#include "common.h"
+#include <array>
+
+/*
+    GL 바인딩 / enable 상태의 shadow copy
+    현재 상태와 같은 값을 다시 설정하는 GL 호출은 생략한다.
+    캐시가 어긋나지 않도록 바인딩 관련 GL 호출은 모두 이 클래스를 거쳐야 하며,
+    오브젝트를 삭제할 때는 Forget*()으로 캐시에서 지운다 (삭제된 이름은 재사용될 수 있음)
+*/
+class RenderState {
+public:
+    static RenderState& Get();
+
+    struct Stats {
+        uint64_t issuedCount { 0 };
+        uint64_t avoidedCount { 0 };
+    };
+
+    void UseProgram(uint32_t program);
+    void BindVertexArray(uint32_t vertexArray);
+    void BindBuffer(uint32_t target, uint32_t buffer);
+    void BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer);
+    // unit은 0부터 시작하는 텍스처 슬롯 번호 (GL_TEXTURE0 + unit)
+    void ActiveTexture(uint32_t unit);
+    // 현재 active unit에 바인딩
+    void BindTexture(uint32_t target, uint32_t texture);
+    void BindTextureUnit(uint32_t unit, uint32_t target, uint32_t texture);
+    void SetEnabled(uint32_t capability, bool enabled);
+    void Enable(uint32_t capability) { SetEnabled(capability, true); }
+    void Disable(uint32_t capability) { SetEnabled(capability, false); }
+
+    void ForgetProgram(uint32_t program);
+    void ForgetVertexArray(uint32_t vertexArray);
+    void ForgetBuffer(uint32_t buffer);
+    void ForgetTexture(uint32_t texture);
+    // 외부 코드가 GL 상태를 직접 바꾼 경우 캐시 전체를 무효화
+    void Invalidate();
+
+    const Stats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = Stats(); }
+
+private:
+    RenderState() { Invalidate(); }
+    bool Check(bool changed);
+
+    static constexpr uint32_t kUnknown = 0xffffffff;
+    static constexpr size_t kTextureUnitCount = 32;
+    static constexpr size_t kBufferTargetCount = 7;
+    static constexpr size_t kTextureTargetCount = 2;
+    static constexpr size_t kCapabilityCount = 5;
+    static int GetBufferTargetIndex(uint32_t target);
+    static int GetTextureTargetIndex(uint32_t target);
+    static int GetCapabilityIndex(uint32_t capability);
+
+    uint32_t m_program;
+    uint32_t m_vertexArray;
+    uint32_t m_activeTexture;
+    std::array<uint32_t, kBufferTargetCount> m_buffers;
+    std::array<std::array<uint32_t, kTextureTargetCount>, kTextureUnitCount> m_textures;
+    // 0: disabled, 1: enabled, kUnknown: 알 수 없음
+    std::array<uint32_t, kCapabilityCount> m_capabilities;
+    Stats m_stats;
+};
+
+#endif // __RENDER_STATE_H__
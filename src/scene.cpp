@@ -0,0 +1,133 @@
+#include "scene.h"
+#include "profiler.h"
+
+SceneUPtr Scene::Create(JobSystem* jobSystem, size_t reserveCount) {
+    auto scene = SceneUPtr(new Scene());
+    scene->Init(jobSystem, reserveCount);
+    return std::move(scene);
+}
+
+void Scene::Init(JobSystem* jobSystem, size_t reserveCount) {
+    m_jobSystem = jobSystem;
+    m_parents.reserve(reserveCount);
+    m_depths.reserve(reserveCount);
+    m_positions.reserve(reserveCount);
+    m_rotations.reserve(reserveCount);
+    m_scales.reserve(reserveCount);
+    m_dirty.reserve(reserveCount);
+    m_worldTransforms.reserve(reserveCount);
+}
+
+uint32_t Scene::AddNode(uint32_t parent, const glm::vec3& position,
+    const glm::quat& rotation, const glm::vec3& scale) {
+    uint32_t node = (uint32_t)GetNodeCount();
+    if (parent != kInvalidNode && parent >= node) {
+        SPDLOG_ERROR("invalid parent node: {}", parent);
+        parent = kInvalidNode;
+    }
+    m_parents.push_back(parent);
+    m_depths.push_back(parent == kInvalidNode ? 0 : m_depths[parent] + 1);
+    m_positions.push_back(position);
+    m_rotations.push_back(rotation);
+    m_scales.push_back(scale);
+    m_dirty.push_back(0);
+    m_worldTransforms.push_back(glm::mat4(1.0f));
+    MarkDirty(node);
+    return node;
+}
+
+void Scene::MarkDirty(uint32_t node) {
+    if (!m_dirty[node]) {
+        m_dirty[node] = 1;
+        m_firstDirty = std::min(m_firstDirty, (size_t)node);
+    }
+}
+
+void Scene::SetLocalPosition(uint32_t node, const glm::vec3& position) {
+    m_positions[node] = position;
+    MarkDirty(node);
+}
+
+void Scene::SetLocalRotation(uint32_t node, const glm::quat& rotation) {
+    m_rotations[node] = rotation;
+    MarkDirty(node);
+}
+
+void Scene::SetLocalScale(uint32_t node, const glm::vec3& scale) {
+    m_scales[node] = scale;
+    MarkDirty(node);
+}
+
+void Scene::SetSpin(uint32_t node, const glm::vec3& axis, float speed, float offset) {
+    m_spins.push_back({ node, glm::normalize(axis),
+        glm::radians(speed), glm::radians(offset) });
+}
+
+void Scene::Update(float time) {
+    PROFILE_SCOPE("Scene::Update");
+    m_updatedNodeCount = 0;
+
+    // 회전하는 노드의 local rotation 갱신
+    m_jobSystem->ParallelFor(m_spins.size(), kGrainSize, [this, time](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            auto& spin = m_spins[i];
+            m_rotations[spin.node] = glm::angleAxis(time * spin.speed + spin.offset, spin.axis);
+        }
+    });
+    for (auto& spin : m_spins)
+        MarkDirty(spin.node);
+
+    size_t nodeCount = GetNodeCount();
+    if (m_firstDirty >= nodeCount)
+        return;
+
+    // 부모가 항상 앞에 있으므로 한번의 순회로 dirty flag를 자손에게 전파하고
+    // 갱신할 노드를 깊이별로 모은다
+    for (auto& level : m_levels)
+        level.clear();
+    for (size_t i = m_firstDirty; i < nodeCount; i++) {
+        uint32_t parent = m_parents[i];
+        if (parent != kInvalidNode && m_dirty[parent])
+            m_dirty[i] = 1;
+        if (!m_dirty[i])
+            continue;
+        uint32_t depth = m_depths[i];
+        if (depth >= m_levels.size())
+            m_levels.resize(depth + 1);
+        m_levels[depth].push_back((uint32_t)i);
+    }
+
+    // 같은 깊이의 노드는 부모의 world 행렬이 이미 계산되어 있으므로 병렬로 처리
+    for (auto& level : m_levels) {
+        m_jobSystem->ParallelFor(level.size(), kGrainSize, [this, &level](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                uint32_t node = level[i];
+                // local = translate * rotate * scale 를 행렬 곱 없이 구성
+                auto rotation = glm::mat3_cast(m_rotations[node]);
+                auto& scale = m_scales[node];
+                glm::mat4 local;
+                local[0] = glm::vec4(rotation[0] * scale.x, 0.0f);
+                local[1] = glm::vec4(rotation[1] * scale.y, 0.0f);
+                local[2] = glm::vec4(rotation[2] * scale.z, 0.0f);
+                local[3] = glm::vec4(m_positions[node], 1.0f);
+
+                uint32_t parent = m_parents[node];
+                m_worldTransforms[node] = parent == kInvalidNode ?
+                    local : m_worldTransforms[parent] * local;
+                m_dirty[node] = 0;
+            }
+        });
+        m_updatedNodeCount += level.size();
+    }
+    m_firstDirty = nodeCount;
+}
+
+void Scene::GatherTransforms(const std::vector<uint32_t>& indices,
+    std::vector<glm::mat4>& transforms) const {
+    PROFILE_SCOPE("Scene::GatherTransforms");
+    transforms.resize(indices.size());
+    m_jobSystem->ParallelFor(indices.size(), kGrainSize, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            transforms[i] = m_worldTransforms[indices[i]];
+    });
+}
@@ -0,0 +1,87 @@
+#ifndef __SCENE_H__
+#define __SCENE_H__
+
+#include "common.h"
+#include "job_system.h"
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+
+/*
+    flat array 형태의 계층 장면 (scene graph)
+    - 노드는 부모보다 항상 뒤에 추가되므로 배열 순서가 곧 위상 정렬 순서
+    - 노드마다 local TRS와 dirty flag를 두고, Update에서는 바뀐 노드와 그 자손의
+      world 행렬만 다시 계산한다. 바뀐 노드가 없으면 아무 일도 하지 않는다
+    - 같은 깊이의 노드끼리는 서로 의존하지 않으므로 깊이 단위로 job system에서 병렬 처리
+    world 행렬은 instancing에 바로 쓸 수 있는 연속된 mat4 배열에 기록되고
+    GL thread는 GetTransforms()의 결과만 읽는다.
+*/
+CLASS_PTR(Scene)
+class Scene {
+public:
+    static constexpr uint32_t kInvalidNode = 0xffffffff;
+
+    static SceneUPtr Create(JobSystem* jobSystem, size_t reserveCount = 1024);
+
+    // parent는 이미 추가된 노드여야 한다. 반환값은 node index
+    uint32_t AddNode(uint32_t parent = kInvalidNode,
+        const glm::vec3& position = glm::vec3(0.0f),
+        const glm::quat& rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+        const glm::vec3& scale = glm::vec3(1.0f));
+    size_t GetNodeCount() const { return m_parents.size(); }
+    uint32_t GetParent(uint32_t node) const { return m_parents[node]; }
+
+    const glm::vec3& GetLocalPosition(uint32_t node) const { return m_positions[node]; }
+    const glm::quat& GetLocalRotation(uint32_t node) const { return m_rotations[node]; }
+    const glm::vec3& GetLocalScale(uint32_t node) const { return m_scales[node]; }
+    void SetLocalPosition(uint32_t node, const glm::vec3& position);
+    void SetLocalRotation(uint32_t node, const glm::quat& rotation);
+    void SetLocalScale(uint32_t node, const glm::vec3& scale);
+
+    // 매 프레임 axis 기준으로 회전하는 노드. speed, offset: degree / sec, degree
+    void SetSpin(uint32_t node, const glm::vec3& axis, float speed, float offset);
+
+    // time(sec) 시점의 회전을 적용하고 바뀐 노드의 world 행렬을 갱신
+    void Update(float time);
+    // 직전 Update에서 world 행렬을 다시 계산한 노드 수
+    size_t GetUpdatedNodeCount() const { return m_updatedNodeCount; }
+
+    const std::vector<glm::mat4>& GetTransforms() const { return m_worldTransforms; }
+    // indices에 해당하는 world 행렬만 연속된 배열로 모은다 (culling 결과 등)
+    void GatherTransforms(const std::vector<uint32_t>& indices,
+        std::vector<glm::mat4>& transforms) const;
+
+private:
+    Scene() {}
+    void Init(JobSystem* jobSystem, size_t reserveCount);
+    void MarkDirty(uint32_t node);
+
+    // job 하나가 처리할 노드 수. 너무 작으면 분배 비용이 계산 비용보다 커진다
+    static constexpr size_t kGrainSize = 1024;
+
+    struct Spin {
+        uint32_t node;
+        glm::vec3 axis;
+        float speed;  // radian / sec
+        float offset; // radian
+    };
+
+    JobSystem* m_jobSystem { nullptr };
+
+    // 노드별 데이터 (node index로 접근)
+    std::vector<uint32_t> m_parents;
+    std::vector<uint32_t> m_depths;
+    std::vector<glm::vec3> m_positions;
+    std::vector<glm::quat> m_rotations;
+    std::vector<glm::vec3> m_scales;
+    std::vector<uint8_t> m_dirty;
+    std::vector<glm::mat4> m_worldTransforms;
+
+    std::vector<Spin> m_spins;
+    // 가장 앞의 dirty 노드. 이보다 앞의 노드는 검사할 필요가 없다
+    size_t m_firstDirty { 0 };
+    // Update 중 깊이별로 모은 갱신 대상 노드
+    std::vector<std::vector<uint32_t>> m_levels;
+    size_t m_updatedNodeCount { 0 };
+};
+
+#endif // __SCENE_H__
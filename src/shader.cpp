@@ -1,34 +1,204 @@
 #include "shader.h"
+#include "mapped_file.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
 
-ShaderUPtr Shader::CreateFromFile(const std::string& filename, GLenum shaderType) {
+namespace fs = std::filesystem;
+
+// #include 중첩 제한 (순환 include는 한번만 포함하는 규칙으로 막히지만 안전장치)
+static constexpr size_t kMaxIncludeFileCount = 64;
+
+// 앞뒤가 식별자 문자가 아닌 위치에 name이 등장하는지 (SIZE가 MAX_SIZE 안에서 찾히지 않도록)
+static bool ContainsIdentifier(std::string_view source, std::string_view name) {
+    auto isIdentifier = [](char c) { return std::isalnum((unsigned char)c) || c == '_'; };
+    for (size_t pos = source.find(name); pos != std::string_view::npos; pos = source.find(name, pos + 1)) {
+        size_t end = pos + name.size();
+        if ((pos == 0 || !isIdentifier(source[pos - 1])) &&
+            (end == source.size() || !isIdentifier(source[end])))
+            return true;
+    }
+    return false;
+}
+
+/*
+    #version 줄 바로 다음 위치를 찾는다. #version 앞에는 빈 줄과 주석만 올 수 있다 (GLSL 규칙)
+    nextLine: 그 위치의 줄 번호. #version이 없으면 0을 돌려주고 nextLine은 1
+*/
+static size_t FindVersionEnd(std::string_view source, size_t& nextLine) {
+    bool inComment = false;
+    size_t lineNumber = 0;
+    size_t pos = 0;
+    nextLine = 1;
+    while (pos < source.size()) {
+        size_t end = source.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = source.size();
+        auto line = source.substr(pos, end - pos);
+        pos = std::min(end + 1, source.size());
+        lineNumber++;
+
+        // 블록 주석을 걷어내고 남은 내용 확인
+        while (!line.empty()) {
+            if (inComment) {
+                size_t close = line.find("*/");
+                if (close == std::string_view::npos) {
+                    line = {};
+                    break;
+                }
+                line.remove_prefix(close + 2);
+                inComment = false;
+            }
+            size_t first = line.find_first_not_of(" \t\r");
+            line.remove_prefix(first == std::string_view::npos ? line.size() : first);
+            if (line.rfind("/*", 0) != 0)
+                break;
+            line.remove_prefix(2);
+            inComment = true;
+        }
+        if (line.empty() || line.rfind("//", 0) == 0)
+            continue;
+        if (line[0] == '#') {
+            auto directive = line.substr(1);
+            size_t first = directive.find_first_not_of(" \t");
+            if (first != std::string_view::npos && directive.substr(first).rfind("version", 0) == 0) {
+                nextLine = lineNumber + 1;
+                return pos;
+            }
+        }
+        return 0;
+    }
+    return 0;
+}
+
+ShaderUPtr Shader::CreateFromFile(const std::string& filename, GLenum shaderType,
+    const ShaderDefines& defines) {
     auto shader = ShaderUPtr(new Shader());
-    if (!shader->LoadFile(filename, shaderType))
+    if (!shader->LoadFile(filename, shaderType, defines))
        return nullptr;
     return std::move(shader);
 }
 
-bool Shader::LoadFile(const std::string& filename, GLenum shaderType) {
-    auto result = LoadTextFile(filename);
-    if (!result.has_value())
+bool Shader::AppendFile(const std::string& filename, std::string& source) {
+    if (std::find(m_files.begin(), m_files.end(), filename) != m_files.end())
+        return true;
+    if (m_files.size() >= kMaxIncludeFileCount) {
+        SPDLOG_ERROR("too many shader includes: \"{}\"", m_filename);
+        return false;
+    }
+    auto file = MappedFile::Open(filename);
+    if (!file)
+        return false;
+    // #line의 source string 번호로 파일 순서를 사용하여 컴파일 에러 위치를 찾을 수 있게 한다
+    uint32_t fileIndex = (uint32_t)m_files.size();
+    m_files.push_back(filename);
+    if (fileIndex > 0)
+        source += fmt::format("#line 1 {}\n", fileIndex);
+
+    auto text = file->GetText();
+    // UTF-8 BOM은 GLSL 컴파일러가 처리하지 못하므로 제거
+    if (text.rfind("\xEF\xBB\xBF", 0) == 0)
+        text.remove_prefix(3);
+    auto directory = fs::path(filename).parent_path();
+    size_t lineNumber = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = text.size();
+        auto line = text.substr(pos, end - pos);
+        pos = end + 1;
+        lineNumber++;
+
+        auto first = line.find_first_not_of(" \t");
+        if (first != std::string_view::npos && line.substr(first).rfind("#include", 0) == 0) {
+            auto open = line.find('"', first);
+            auto close = open == std::string_view::npos ? open : line.find('"', open + 1);
+            if (close == std::string_view::npos) {
+                SPDLOG_ERROR("invalid #include in \"{}\" line {}", filename, lineNumber);
+                return false;
+            }
+            auto includePath = (directory / std::string(line.substr(open + 1, close - open - 1)))
+                .lexically_normal().generic_string();
+            if (!AppendFile(includePath, source))
+                return false;
+            source += fmt::format("#line {} {}\n", lineNumber + 1, fileIndex);
+            continue;
+        }
+        source.append(line.data(), line.size());
+        source += '\n';
+    }
+    return true;
+}
+
+bool Shader::LoadFile(const std::string& filename, GLenum shaderType, const ShaderDefines& defines) {
+    PROFILE_SCOPE("Shader::LoadFile");
+    m_filename = filename;
+    m_shaderType = shaderType;
+    std::string source;
+    if (!AppendFile(filename, source))
         return false;
 
-    auto& code = result.value();
-    const char* codePtr = code.c_str();
-    int32_t codeLength = (int32_t)code.length();
+    // 소스에 등장하는 define만 이름순으로 남긴다
+    ShaderDefines usedDefines;
+    for (auto& define : defines) {
+        if (ContainsIdentifier(source, define.first))
+            usedDefines.push_back(define);
+    }
+    std::sort(usedDefines.begin(), usedDefines.end());
+    std::string defineBlock;
+    for (auto& define : usedDefines)
+        defineBlock += fmt::format("#define {} {}\n", define.first, define.second);
+
+    // #version 앞에는 다른 내용이 올 수 없으므로 그 다음 줄에 삽입 (앞에 주석이 있어도 됨)
+    size_t nextLine = 1;
+    size_t insertPos = FindVersionEnd(source, nextLine);
+    if (!defineBlock.empty()) {
+        defineBlock += fmt::format("#line {} 0\n", nextLine);
+        source.insert(insertPos, defineBlock);
+    }
+
+    m_source = std::move(source);
+    m_hash = HashString(m_source, HashString(std::to_string(shaderType)));
+    return true;
+}
+
+void Shader::SubmitCompile() {
+    if (m_shader)
+        return;
+    PROFILE_SCOPE("Shader::SubmitCompile");
+    const char* codePtr = m_source.data();
+    int32_t codeLength = (int32_t)m_source.length();
 
     // create and compile shader
-    m_shader = glCreateShader(shaderType);
+    m_shader = glCreateShader(m_shaderType);
     glShaderSource(m_shader, 1, (const GLchar* const*)&codePtr, &codeLength);
     glCompileShader(m_shader);
+    // glShaderSource에서 복사되므로 소스는 더 이상 필요 없음
+    m_source.clear();
+    m_source.shrink_to_fit();
+}
+
+bool Shader::Compile() {
+    SubmitCompile();
+    if (m_checked)
+        return !m_failed;
+    PROFILE_SCOPE("Shader::Compile");
+    m_checked = true;
 
-    // check compile error
+    // check compile error (컴파일이 끝나지 않았으면 여기서 기다린다)
     int success = 0;
     glGetShaderiv(m_shader, GL_COMPILE_STATUS, &success);
     if (!success) {
         char infoLog[1024];
         glGetShaderInfoLog(m_shader, 1024, nullptr, infoLog);
-        SPDLOG_ERROR("failed to compile shader: \"{}\"", filename);
+        SPDLOG_ERROR("failed to compile shader: \"{}\"", m_filename);
+        // 에러 메시지의 "0(12)" 형식에서 앞의 번호가 파일 순서
+        for (size_t i = 1; i < m_files.size(); i++)
+            SPDLOG_ERROR("source {}: \"{}\"", i, m_files[i]);
         SPDLOG_ERROR("reason: {}", infoLog);
+        m_failed = true;
         return false;
     }
     return true;
@@ -38,4 +208,4 @@ Shader::~Shader() {
   if (m_shader) {
     glDeleteShader(m_shader);
   }
-}
\ No newline at end of file
+}
@@ -3,17 +3,51 @@
 
 #include "common.h"
 
+// permutation을 만드는 #define 목록. { "INSTANCED", "1" } 처럼 이름과 값의 쌍
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+/*
+    파일에서 읽어 전처리한 shader 소스
+    - #include "file"은 현재 파일 기준 상대 경로로 펼친다 (같은 파일은 한번만)
+    - defines는 #version 바로 다음 줄에 #define으로 삽입한다
+      소스에 등장하지 않는 이름은 결과에 영향이 없으므로 빼고, 이름순으로 정렬하여
+      같은 결과 소스는 항상 같은 해시가 되도록 한다
+    컴파일은 Compile()을 처음 호출할 때 한다. program binary 캐시에 적중하면
+    소스 컴파일 자체를 건너뛸 수 있도록 생성 시점에는 소스와 해시만 준비한다
+    SubmitCompile()은 glCompileShader만 호출하고 결과를 기다리지 않으므로
+    parallel shader compile을 지원하는 driver는 여러 shader를 동시에 컴파일할 수 있다
+*/
 CLASS_PTR(Shader);
 class Shader {
 public:
-    static ShaderUPtr CreateFromFile(const std::string& filename, GLenum shaderType);
+    static ShaderUPtr CreateFromFile(const std::string& filename, GLenum shaderType,
+        const ShaderDefines& defines = {});
 
     ~Shader();
-    uint32_t Get() const { return m_shader; }    
+    // 아직 컴파일을 요청하지 않았으면 0
+    uint32_t Get() const { return m_shader; }
+    GLenum GetType() const { return m_shaderType; }
+    // shader 종류와 전처리된 소스의 해시. 컴파일 결과 공유 및 program binary 캐시의 key로 사용
+    uint64_t GetHash() const { return m_hash; }
+    // 소스를 구성하는 파일 목록. 0번이 원본, 나머지는 #include된 파일
+    const std::vector<std::string>& GetFiles() const { return m_files; }
+    // 컴파일 요청만 하고 바로 반환
+    void SubmitCompile();
+    // 요청하지 않았으면 요청한 뒤, 컴파일이 끝날 때까지 기다려 성공 여부를 반환
+    bool Compile();
+
 private:
     Shader() {}
-    bool LoadFile(const std::string& filename, GLenum shaderType);
+    bool LoadFile(const std::string& filename, GLenum shaderType, const ShaderDefines& defines);
+    bool AppendFile(const std::string& filename, std::string& source);
+    std::string m_filename;
+    GLenum m_shaderType { 0 };
+    uint64_t m_hash { 0 };
+    std::string m_source;
+    std::vector<std::string> m_files;
+    bool m_checked { false };
+    bool m_failed { false };
     uint32_t m_shader { 0 };
 };
 
-#endif // __SHADER_H__
\ No newline at end of file
+#endif // __SHADER_H__
@@ -0,0 +1,205 @@
+#include "shader_library.h"
+#include "profiler.h"
+#include <algorithm>
+
+ShaderLibraryUPtr ShaderLibrary::Create(const std::string& programCacheDirectory) {
+    auto library = ShaderLibraryUPtr(new ShaderLibrary());
+    if (!library->Init(programCacheDirectory))
+        return nullptr;
+    return std::move(library);
+}
+
+bool ShaderLibrary::Init(const std::string& programCacheDirectory) {
+    // 지원하지 않는 driver에서는 캐시 없이 매번 컴파일. 디렉토리가 비어 있으면 캐시 사용 안함
+    if (!programCacheDirectory.empty())
+        m_programCache = ProgramCache::Create(programCacheDirectory);
+
+    // driver가 사용할 수 있는 만큼 컴파일 thread 사용
+    if (GLAD_GL_KHR_parallel_shader_compile)
+        glMaxShaderCompilerThreadsKHR(0xffffffff);
+    else if (GLAD_GL_ARB_parallel_shader_compile)
+        glMaxShaderCompilerThreadsARB(0xffffffff);
+    SPDLOG_INFO("parallel shader compile: {}",
+        Program::IsParallelCompileSupported() ? "supported" : "not supported");
+    return true;
+}
+
+uint64_t ShaderLibrary::MakeKey(std::string_view name, uint64_t seed, const ShaderDefines& defines) {
+    // defines 순서와 무관한 key
+    auto sorted = defines;
+    std::sort(sorted.begin(), sorted.end());
+    uint64_t key = HashString(name, seed);
+    for (auto& define : sorted) {
+        key = HashString(define.first, key);
+        key = HashString("=", key);
+        key = HashString(define.second, key);
+        key = HashString(";", key);
+    }
+    return key;
+}
+
+uint64_t ShaderLibrary::MakeStageKey(const Shader* vertexShader, const Shader* fragmentShader) {
+    uint64_t stageHashes[] = { vertexShader->GetHash(), fragmentShader->GetHash() };
+    return HashString(std::string_view((const char*)stageHashes, sizeof(stageHashes)));
+}
+
+ShaderPtr ShaderLibrary::GetShader(const std::string& filename, GLenum shaderType,
+    const ShaderDefines& defines) {
+    uint64_t key = MakeKey(filename, HashString(std::to_string(shaderType)), defines);
+    auto it = m_shaders.find(key);
+    if (it != m_shaders.end())
+        return it->second;
+
+    ShaderPtr shader = Shader::CreateFromFile(filename, shaderType, defines);
+    if (!shader)
+        return nullptr;
+    // 전처리 결과가 같은 Shader가 이미 있으면 그것을 공유
+    auto result = m_shadersByHash.emplace(shader->GetHash(), shader);
+    shader = result.first->second;
+    m_shaders.emplace(key, shader);
+    return shader;
+}
+
+ProgramPtr ShaderLibrary::GetProgram(const std::string& vertexFilename,
+    const std::string& fragmentFilename, const ShaderDefines& defines) {
+    auto program = RequestProgram(vertexFilename, fragmentFilename, defines);
+    if (!program || !program->Wait())
+        return nullptr;
+    return program;
+}
+
+ProgramPtr ShaderLibrary::RequestProgram(const std::string& vertexFilename,
+    const std::string& fragmentFilename, const ShaderDefines& defines) {
+    uint64_t key = MakeKey(fragmentFilename, HashString(vertexFilename), defines);
+    auto it = m_programs.find(key);
+    if (it != m_programs.end())
+        return it->second.program;
+
+    PROFILE_SCOPE("ShaderLibrary::RequestProgram");
+    auto vertexShader = GetShader(vertexFilename, GL_VERTEX_SHADER, defines);
+    auto fragmentShader = GetShader(fragmentFilename, GL_FRAGMENT_SHADER, defines);
+    if (!vertexShader || !fragmentShader)
+        return nullptr;
+
+    // 두 stage가 모두 같은 program이 이미 있으면 공유
+    ProgramEntry entry = { vertexFilename, fragmentFilename, defines, vertexShader, fragmentShader, nullptr };
+    uint64_t stageKey = MakeStageKey(vertexShader.get(), fragmentShader.get());
+    auto shared = m_programsByStage.find(stageKey);
+    if (shared != m_programsByStage.end()) {
+        entry.program = shared->second;
+        m_programs.emplace(key, std::move(entry));
+        return shared->second;
+    }
+
+    ProgramPtr program = Program::CreateAsync({ vertexShader, fragmentShader }, m_programCache.get());
+    entry.program = program;
+    m_programs.emplace(key, std::move(entry));
+    m_programsByStage.emplace(stageKey, program);
+    if (program->IsPending())
+        m_pendingPrograms.push_back(program);
+    return program;
+}
+
+void ShaderLibrary::Update() {
+    if (m_pendingPrograms.empty())
+        return;
+    // GetProgram()에서 이미 기다린 program도 여기서 목록에서 빠진다
+    auto it = std::remove_if(m_pendingPrograms.begin(), m_pendingPrograms.end(),
+        [](const ProgramPtr& program) {
+            if (!program->IsLinkComplete())
+                return false;
+            program->Wait();
+            return true;
+        });
+    m_pendingPrograms.erase(it, m_pendingPrograms.end());
+}
+
+bool ShaderLibrary::WaitAll() {
+    bool success = true;
+    for (auto& program : m_pendingPrograms)
+        success = program->Wait() && success;
+    m_pendingPrograms.clear();
+    return success;
+}
+
+std::vector<std::string> ShaderLibrary::GetSourceFiles() const {
+    std::unordered_set<std::string> files;
+    for (auto& shader : m_shadersByHash)
+        files.insert(shader.second->GetFiles().begin(), shader.second->GetFiles().end());
+    return std::vector<std::string>(files.begin(), files.end());
+}
+
+size_t ShaderLibrary::Reload(const std::vector<std::string>& changedFiles) {
+    PROFILE_SCOPE("ShaderLibrary::Reload");
+    std::unordered_set<std::string> changed(changedFiles.begin(), changedFiles.end());
+    auto isChanged = [&](const Shader* shader) {
+        for (auto& file : shader->GetFiles()) {
+            if (changed.count(NormalizePath(file)))
+                return true;
+        }
+        return false;
+    };
+
+    // 변경된 파일을 읽은 shader는 캐시에서 빼서 다음 요청 때 새로 읽게 한다
+    std::unordered_set<const Shader*> staleShaders;
+    for (auto it = m_shadersByHash.begin(); it != m_shadersByHash.end();) {
+        if (isChanged(it->second.get())) {
+            staleShaders.insert(it->second.get());
+            it = m_shadersByHash.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    for (auto it = m_shaders.begin(); it != m_shaders.end();) {
+        if (staleShaders.count(it->second.get()))
+            it = m_shaders.erase(it);
+        else
+            ++it;
+    }
+
+    // 여러 요청이 한 Program을 공유할 수 있으므로 Program 단위로 한번만 다시 만든다
+    std::unordered_map<const Program*, std::pair<ShaderPtr, ShaderPtr>> rebuilt;
+    size_t reloadCount = 0;
+    for (auto& item : m_programs) {
+        auto& entry = item.second;
+        // 이전 reload가 실패해 캐시에 없는 shader일 수도 있으므로 파일 목록으로 확인
+        if (!isChanged(entry.vertexShader.get()) && !isChanged(entry.fragmentShader.get()))
+            continue;
+
+        auto done = rebuilt.find(entry.program.get());
+        if (done == rebuilt.end()) {
+            ShaderPtr vertexShader = GetShader(entry.vertexFilename, GL_VERTEX_SHADER, entry.defines);
+            ShaderPtr fragmentShader = GetShader(entry.fragmentFilename, GL_FRAGMENT_SHADER, entry.defines);
+            ProgramUPtr program;
+            if (vertexShader && fragmentShader)
+                program = Program::Create({ vertexShader, fragmentShader }, m_programCache.get());
+            if (!program) {
+                SPDLOG_ERROR("failed to reload program: \"{}\", \"{}\", keep previous program",
+                    entry.vertexFilename, entry.fragmentFilename);
+                // 이전 shader를 유지하여 파일을 고치면 다시 시도된다
+                done = rebuilt.emplace(entry.program.get(),
+                    std::make_pair(entry.vertexShader, entry.fragmentShader)).first;
+            }
+            else {
+                // ProgramPtr를 가진 쪽은 그대로 두고 GL 객체만 교체
+                entry.program->Swap(*program);
+                for (auto it = m_programsByStage.begin(); it != m_programsByStage.end();) {
+                    if (it->second == entry.program)
+                        it = m_programsByStage.erase(it);
+                    else
+                        ++it;
+                }
+                m_programsByStage[MakeStageKey(vertexShader.get(), fragmentShader.get())] = entry.program;
+                done = rebuilt.emplace(entry.program.get(),
+                    std::make_pair(vertexShader, fragmentShader)).first;
+                reloadCount++;
+            }
+        }
+        entry.vertexShader = done->second.first;
+        entry.fragmentShader = done->second.second;
+    }
+    if (!rebuilt.empty())
+        SPDLOG_INFO("shader reload: {} / {} programs", reloadCount, rebuilt.size());
+    return reloadCount;
+}
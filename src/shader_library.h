@@ -0,0 +1,76 @@
+#ifndef __SHADER_LIBRARY_H__
+#define __SHADER_LIBRARY_H__
+
+#include "common.h"
+#include "shader.h"
+#include "program.h"
+#include "program_cache.h"
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+    (파일, shader 종류, defines) 별 Shader와 그 조합의 Program을 공유하는 캐시
+    - 요청받은 시점에 처음 만들고, 이후 같은 요청에는 같은 객체를 돌려준다
+    - 다른 defines로 요청했더라도 전처리 결과가 같은 stage는 하나의 Shader를 공유한다
+      ex) INSTANCED는 vertex shader에만 등장하므로 fragment shader는 한번만 컴파일
+    - shader 컴파일은 그 stage를 쓰는 program이 처음 link될 때 한다
+      program binary 캐시에 적중하면 컴파일 없이 끝난다
+    - RequestProgram()으로 여러 program의 컴파일 / link를 먼저 모두 요청해 두면
+      driver가 자체 thread에서 병렬로 처리하고, GetProgram()으로 처음 필요할 때만 기다린다
+    - Reload()는 변경된 파일을 사용하는 program만 다시 만들어 같은 Program 객체에 교체한다
+*/
+CLASS_PTR(ShaderLibrary)
+class ShaderLibrary {
+public:
+    static ShaderLibraryUPtr Create(const std::string& programCacheDirectory = "./cache/program");
+
+    ShaderPtr GetShader(const std::string& filename, GLenum shaderType,
+        const ShaderDefines& defines = {});
+    // 컴파일 / link를 요청만 하고 반환. 반환된 program은 Wait() 전에는 사용할 수 없다
+    ProgramPtr RequestProgram(const std::string& vertexFilename, const std::string& fragmentFilename,
+        const ShaderDefines& defines = {});
+    // link가 끝날 때까지 기다린 program. 실패하면 nullptr
+    ProgramPtr GetProgram(const std::string& vertexFilename, const std::string& fragmentFilename,
+        const ShaderDefines& defines = {});
+    // 프레임 사이에 호출. 기다리지 않고 끝난 program만 마무리한다
+    void Update();
+    // 요청된 program을 모두 마무리. 하나라도 실패하면 false
+    bool WaitAll();
+    size_t GetPendingCount() const { return m_pendingPrograms.size(); }
+
+    // 변경된 파일(NormalizePath 형식)을 소스로 사용하는 program을 다시 컴파일하여 교체
+    // 실패하면 이전 program을 그대로 사용한다. 교체된 program 개수를 반환
+    size_t Reload(const std::vector<std::string>& changedFiles);
+    // 지금까지 읽은 shader 소스 파일 (#include 포함)
+    std::vector<std::string> GetSourceFiles() const;
+
+    // program binary 캐시를 지원하지 않으면 nullptr
+    const ProgramCache* GetProgramCache() const { return m_programCache.get(); }
+    size_t GetShaderCount() const { return m_shadersByHash.size(); }
+    size_t GetProgramCount() const { return m_programsByStage.size(); }
+
+private:
+    ShaderLibrary() {}
+    bool Init(const std::string& programCacheDirectory);
+    static uint64_t MakeKey(std::string_view name, uint64_t seed, const ShaderDefines& defines);
+    static uint64_t MakeStageKey(const Shader* vertexShader, const Shader* fragmentShader);
+
+    ProgramCacheUPtr m_programCache;
+    // 요청 key -> Shader, 전처리된 소스 해시 -> Shader
+    std::unordered_map<uint64_t, ShaderPtr> m_shaders;
+    std::unordered_map<uint64_t, ShaderPtr> m_shadersByHash;
+    // 요청 key -> Program, stage 해시 쌍 -> Program
+    struct ProgramEntry {
+        std::string vertexFilename;
+        std::string fragmentFilename;
+        ShaderDefines defines;
+        ShaderPtr vertexShader;
+        ShaderPtr fragmentShader;
+        ProgramPtr program;
+    };
+    std::unordered_map<uint64_t, ProgramEntry> m_programs;
+    std::unordered_map<uint64_t, ProgramPtr> m_programsByStage;
+    std::vector<ProgramPtr> m_pendingPrograms;
+};
+
+#endif // __SHADER_LIBRARY_H__
@@ -0,0 +1,109 @@
+#include "stream_buffer.h"
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+StreamBufferUPtr StreamBuffer::Create(uint32_t bufferType,
+    size_t frameSize, uint32_t frameCount) {
+    auto streamBuffer = StreamBufferUPtr(new StreamBuffer());
+    if (!streamBuffer->Init(bufferType, frameSize, frameCount))
+        return nullptr;
+    return std::move(streamBuffer);
+}
+
+StreamBuffer::~StreamBuffer() {
+    for (auto fence : m_fences) {
+        if (fence)
+            glDeleteSync(fence);
+    }
+}
+
+bool StreamBuffer::Init(uint32_t bufferType, size_t frameSize, uint32_t frameCount) {
+    m_frameSize = frameSize;
+    m_fences.resize(frameCount, nullptr);
+    m_buffer = Buffer::CreateWithData(bufferType, GL_STREAM_DRAW,
+        nullptr, m_frameSize * frameCount);
+    return m_buffer ? true : false;
+}
+
+void StreamBuffer::WaitFence(uint32_t frame) {
+    auto& fence = m_fences[frame];
+    if (!fence)
+        return;
+    // 이미 signal 되었으면 대기 없이 통과
+    auto result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        auto start = std::chrono::steady_clock::now();
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1ms
+        } while (result == GL_TIMEOUT_EXPIRED);
+        auto waitTime = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        m_stats.fenceWaitCount++;
+        m_stats.fenceWaitTime += waitTime;
+        Profiler::Get().AddCounter(ProfileCounter::FenceWait, (uint64_t)(waitTime * 1000.0));
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void StreamBuffer::BeginFrame(size_t requiredSize) {
+    m_frameOffset = 0;
+    requiredSize = std::max(requiredSize, m_requiredSize);
+    m_requiredSize = 0;
+    if (requiredSize > m_frameSize) {
+        // 구간 크기를 두 배씩 늘린다. 아직 이번 프레임의 offset을 돌려주기 전이므로 안전
+        size_t frameSize = std::max<size_t>(m_frameSize, 256);
+        while (requiredSize > frameSize)
+            frameSize *= 2;
+        Resize(frameSize);
+    }
+    WaitFence(m_frame);
+}
+
+void StreamBuffer::Resize(size_t frameSize) {
+    // 새 저장공간을 할당하면 이전 내용은 드라이버가 관리하므로 fence도 필요 없음
+    for (auto& fence : m_fences) {
+        if (fence)
+            glDeleteSync(fence);
+        fence = nullptr;
+    }
+    SPDLOG_INFO("stream buffer resized: {} -> {} bytes per frame", m_frameSize, frameSize);
+    m_frameSize = frameSize;
+    m_buffer->SetData(nullptr, m_frameSize * m_fences.size());
+}
+
+size_t StreamBuffer::Write(const void* data, size_t size, size_t alignment) {
+    alignment = std::max<size_t>(alignment, 1);
+    size_t offset = (m_frameOffset + alignment - 1) / alignment * alignment;
+    if (offset + size > m_frameSize) {
+        // 프레임 도중에 버퍼를 다시 할당하면 이미 쓴 데이터와 offset이 무효가 되므로 실패 처리
+        SPDLOG_ERROR("stream buffer overflow: {} bytes needed, {} bytes per frame",
+            offset + size, m_frameSize);
+        m_requiredSize = std::max(m_requiredSize, offset + size);
+        return kInvalidOffset;
+    }
+
+    size_t bufferOffset = m_frame * m_frameSize + offset;
+    void* ptr = m_buffer->Map(bufferOffset, size,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    if (!ptr) {
+        SPDLOG_ERROR("failed to map stream buffer");
+        return kInvalidOffset;
+    }
+    memcpy(ptr, data, size);
+    m_buffer->Unmap();
+
+    m_frameOffset = offset + size;
+    m_stats.streamedSize += size;
+    Profiler::Get().AddCounter(ProfileCounter::StreamBytes, size);
+    return bufferOffset;
+}
+
+void StreamBuffer::EndFrame() {
+    m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_frame = (m_frame + 1) % (uint32_t)m_fences.size();
+    m_lastFrameStats = m_stats;
+    m_stats = Stats();
+}
@@ -0,0 +1,59 @@
+#ifndef __STREAM_BUFFER_H__
+#define __STREAM_BUFFER_H__
+
+#include "buffer.h"
+
+/*
+    매 프레임 새로 쓰는 정점 / 인스턴스 데이터용 버퍼
+    버퍼를 frameCount개의 구간으로 나누어 프레임마다 돌아가며 사용하고
+    각 구간을 다 쓴 뒤에는 fence를 걸어둔다.
+    구간을 다시 사용할 때만 그 fence를 확인하므로, 보통은 CPU가 GPU를 기다리지 않으며
+    쓰기는 GL_MAP_UNSYNCHRONIZED_BIT로 map 하여 드라이버 동기화도 피한다.
+    이미 돌려준 offset이 무효가 되지 않도록 버퍼 크기는 BeginFrame()에서만 늘린다.
+*/
+CLASS_PTR(StreamBuffer)
+class StreamBuffer {
+public:
+    struct Stats {
+        size_t streamedSize { 0 };
+        uint32_t fenceWaitCount { 0 };
+        double fenceWaitTime { 0.0 }; // ms
+    };
+
+    static constexpr size_t kInvalidOffset = ~(size_t)0;
+
+    static StreamBufferUPtr Create(uint32_t bufferType,
+        size_t frameSize, uint32_t frameCount = 3);
+    ~StreamBuffer();
+
+    const Buffer* GetBuffer() const { return m_buffer.get(); }
+    size_t GetFrameSize() const { return m_frameSize; }
+
+    // 이번 프레임 구간을 사용할 수 있을 때까지 (필요하면) fence 대기
+    // 구간이 requiredSize(또는 이전 프레임에 넘친 크기)보다 작으면 offset을 나눠주기 전에 늘린다
+    void BeginFrame(size_t requiredSize = 0);
+    // 이번 프레임 구간에 데이터를 쓰고 버퍼 내 offset을 돌려준다
+    // 구간이 모자라면 kInvalidOffset을 돌려주고, 다음 BeginFrame()에서 구간을 늘린다
+    size_t Write(const void* data, size_t size, size_t alignment = 16);
+    // 이번 프레임 구간 사용이 끝났음을 표시하는 fence를 건다
+    void EndFrame();
+
+    const Stats& GetLastFrameStats() const { return m_lastFrameStats; }
+
+private:
+    StreamBuffer() {}
+    bool Init(uint32_t bufferType, size_t frameSize, uint32_t frameCount);
+    void Resize(size_t frameSize);
+    void WaitFence(uint32_t frame);
+
+    BufferUPtr m_buffer;
+    size_t m_frameSize { 0 };
+    uint32_t m_frame { 0 };
+    size_t m_frameOffset { 0 };
+    size_t m_requiredSize { 0 };
+    std::vector<GLsync> m_fences;
+    Stats m_stats;
+    Stats m_lastFrameStats;
+};
+
+#endif // __STREAM_BUFFER_H__
@@ -1,4 +1,6 @@
 #include "texture.h"
+#include "profiler.h"
+#include "render_state.h"
 
 TextureUPtr Texture::CreateFromImage(const Image* image) {
     auto texture = TextureUPtr(new Texture());
@@ -7,24 +9,46 @@ TextureUPtr Texture::CreateFromImage(const Image* image) {
     return std::move(texture);
 }
 
+TextureUPtr Texture::Create(int width, int height, uint32_t format, int levelCount) {
+    auto texture = TextureUPtr(new Texture());
+    texture->CreateTexture();
+    texture->SetTextureFormat(width, height, format, levelCount);
+    return std::move(texture);
+}
+
+TextureUPtr Texture::CreateArray(int width, int height, int layerCount, uint32_t format, int levelCount) {
+    auto texture = TextureUPtr(new Texture());
+    texture->m_target = GL_TEXTURE_2D_ARRAY;
+    texture->CreateTexture();
+    texture->SetTextureArrayFormat(width, height, layerCount, format, levelCount);
+    return std::move(texture);
+}
+
 Texture::~Texture() {
     if (m_texture) {
+        RenderState::Get().ForgetTexture(m_texture);
         glDeleteTextures(1, &m_texture);
     }
 }
 
 void Texture::Bind() const {
-    glBindTexture(GL_TEXTURE_2D, m_texture);
+    RenderState::Get().BindTexture(m_target, m_texture);
+}
+
+void Texture::Bind(uint32_t unit) const {
+    RenderState::Get().BindTextureUnit(unit, m_target, m_texture);
 }
 
 void Texture::SetFilter(uint32_t minFilter, uint32_t magFilter) const {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+    Bind();
+    glTexParameteri(m_target, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(m_target, GL_TEXTURE_MAG_FILTER, magFilter);
 }
 
 void Texture::SetWrap(uint32_t sWrap, uint32_t tWrap) const {
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, sWrap);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, tWrap);
+    Bind();
+    glTexParameteri(m_target, GL_TEXTURE_WRAP_S, sWrap);
+    glTexParameteri(m_target, GL_TEXTURE_WRAP_T, tWrap);
 }
     
 void Texture::CreateTexture() {
@@ -35,14 +59,21 @@ void Texture::CreateTexture() {
     SetWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
 }
 
-void Texture::SetTextureFromImage(const Image* image) {
-    GLenum format = GL_RGBA;
-    switch (image->GetChannelCount()) {
-        default: break;
-        case 1: format = GL_RED; break;
-        case 2: format = GL_RG; break;
-        case 3: format = GL_RGB; break;
+uint32_t Texture::GetImageFormat(int channelCount) {
+    switch (channelCount) {
+        default: return GL_RGBA;
+        case 1: return GL_RED;
+        case 2: return GL_RG;
+        case 3: return GL_RGB;
     }
+}
+
+void Texture::SetTextureFromImage(const Image* image) {
+    PROFILE_SCOPE("Texture::SetTextureFromImage");
+    Bind();
+    m_width = image->GetWidth();
+    m_height = image->GetHeight();
+    m_format = GetImageFormat(image->GetChannelCount());
     
     /*
         바인딩된 텍스처의 크기 / 픽셀 포맷을 설정하고 GPU에 이미지 데이터를 복사
@@ -57,9 +88,75 @@ void Texture::SetTextureFromImage(const Image* image) {
         data: 이미지 데이터가 기록된 메모리 주소
     */
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-        image->GetWidth(), image->GetHeight(), 0,
-        format, GL_UNSIGNED_BYTE,
+        m_width, m_height, 0,
+        m_format, GL_UNSIGNED_BYTE,
         image->GetData());
 
     glGenerateMipmap(GL_TEXTURE_2D);
-}
\ No newline at end of file
+}
+
+void Texture::SetTextureFormat(int width, int height, uint32_t format, int levelCount) {
+    Bind();
+    m_width = width;
+    m_height = height;
+    m_format = format;
+    // 데이터 없이 저장공간만 할당
+    for (int i = 0; i < levelCount; i++) {
+        glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA,
+            std::max(width >> i, 1), std::max(height >> i, 1), 0,
+            m_format, GL_UNSIGNED_BYTE,
+            nullptr);
+    }
+    // 나머지 레벨이 없어도 텍스처가 complete가 되도록 사용할 레벨을 제한
+    if (levelCount > 1)
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+}
+
+void Texture::SetTextureArrayFormat(int width, int height, int layerCount, uint32_t format, int levelCount) {
+    Bind();
+    m_width = width;
+    m_height = height;
+    m_layerCount = layerCount;
+    m_format = format;
+    // layer 수는 mip 레벨이 내려가도 줄지 않는다
+    for (int i = 0; i < levelCount; i++) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, i, GL_RGBA,
+            std::max(width >> i, 1), std::max(height >> i, 1), layerCount, 0,
+            m_format, GL_UNSIGNED_BYTE,
+            nullptr);
+    }
+    if (levelCount > 1)
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+}
+
+void Texture::UpdateRegion(int x, int y, int width, int height, const void* data, int level) const {
+    Bind();
+    // 행 단위 4byte 정렬을 가정하지 않음 (RGB 이미지 등)
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, level, x, y, width, height,
+        m_format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void Texture::UpdateLayer(int layer, const void* data, int level) const {
+    Bind();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer,
+        std::max(m_width >> level, 1), std::max(m_height >> level, 1), 1,
+        m_format, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void Texture::GenerateMipmap() const {
+    Bind();
+    glGenerateMipmap(m_target);
+}
+
+void Texture::Swap(Texture& other) {
+    std::swap(m_texture, other.m_texture);
+    std::swap(m_target, other.m_target);
+    std::swap(m_layerCount, other.m_layerCount);
+    std::swap(m_width, other.m_width);
+    std::swap(m_height, other.m_height);
+    std::swap(m_format, other.m_format);
+}
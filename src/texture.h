@@ -2,24 +2,54 @@
 #define __TEXTURE_H__
 
 #include "image.h"
+#include "texture_cache.h"
 
 CLASS_PTR(Texture)
 class Texture {
 public:
     static TextureUPtr CreateFromImage(const Image* image);
+    // levelCount만큼의 mip 레벨 저장공간을 데이터 없이 할당
+    static TextureUPtr Create(int width, int height, uint32_t format, int levelCount = 1);
+    // 같은 크기의 layer를 쌓은 GL_TEXTURE_2D_ARRAY. 저장공간만 할당
+    static TextureUPtr CreateArray(int width, int height, int layerCount, uint32_t format, int levelCount = 1);
+    // 이미지 채널 수에 맞는 GL 픽셀 포맷
+    static uint32_t GetImageFormat(int channelCount);
     ~Texture();
 
     const uint32_t Get() const { return m_texture; }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    uint32_t GetFormat() const { return m_format; }
+    // GL_TEXTURE_2D 또는 GL_TEXTURE_2D_ARRAY
+    uint32_t GetTarget() const { return m_target; }
+    int GetLayerCount() const { return m_layerCount; }
     void Bind() const;
+    // 지정한 텍스처 슬롯에 바인딩
+    void Bind(uint32_t unit) const;
     void SetFilter(uint32_t minFilter, uint32_t magFilter) const;
     void SetWrap(uint32_t sWrap, uint32_t tWrap) const;
+    void SetTextureFromImage(const Image* image);
+    void SetTextureFormat(int width, int height, uint32_t format, int levelCount = 1);
+    void SetTextureArrayFormat(int width, int height, int layerCount, uint32_t format, int levelCount = 1);
+    // 텍스처 level의 일부 영역만 갱신. GL_PIXEL_UNPACK_BUFFER가 바인딩되어 있으면
+    // data는 해당 버퍼 내의 offset으로 해석된다
+    void UpdateRegion(int x, int y, int width, int height, const void* data, int level = 0) const;
+    // texture array의 layer 하나 전체를 갱신
+    void UpdateLayer(int layer, const void* data, int level = 0) const;
+    void GenerateMipmap() const;
+    // 두 텍스처의 GL 오브젝트를 교환 (스트리밍 완료 후 교체용)
+    void Swap(Texture& other);
     
 private:
     Texture() {}
     void CreateTexture();
-    void SetTextureFromImage(const Image* image);
 
     uint32_t m_texture { 0 };
+    uint32_t m_target { GL_TEXTURE_2D };
+    int m_width { 0 };
+    int m_height { 0 };
+    int m_layerCount { 1 };
+    uint32_t m_format { GL_RGBA };
 };
 
 #endif // __TEXTURE_H__
\ No newline at end of file
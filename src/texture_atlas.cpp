@@ -0,0 +1,188 @@
+#include "texture_atlas.h"
+#include "image_ops.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+TextureAtlasUPtr TextureAtlas::CreateAtlas(const std::vector<const Image*>& images,
+    int maxSize, int padding) {
+    auto atlas = TextureAtlasUPtr(new TextureAtlas());
+    if (!atlas->InitAtlas(images, maxSize, padding))
+        return nullptr;
+    return std::move(atlas);
+}
+
+TextureAtlasUPtr TextureAtlas::CreateArray(const std::vector<const Image*>& images) {
+    auto atlas = TextureAtlasUPtr(new TextureAtlas());
+    if (!atlas->InitArray(images))
+        return nullptr;
+    return std::move(atlas);
+}
+
+bool TextureAtlas::Pack(const std::vector<glm::ivec2>& sizes, int maxSize, int padding,
+    int& width, int& height, std::vector<glm::ivec2>& positions) {
+    // 큰 것부터 넣어야 skyline에 생기는 빈틈이 적다
+    std::vector<size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return sizes[a].y != sizes[b].y ? sizes[a].y > sizes[b].y : sizes[a].x > sizes[b].x;
+    });
+
+    // 짧은 변을 두배씩 늘려가며 (정사각형 또는 2:1) 전체 넓이가 들어가는 크기부터 시도
+    uint64_t area = 0;
+    for (auto& size : sizes)
+        area += (uint64_t)(size.x + padding * 2) * (size.y + padding * 2);
+    width = 1;
+    height = 1;
+    auto grow = [&]() {
+        if (width <= height)
+            width *= 2;
+        else
+            height *= 2;
+    };
+    while ((uint64_t)width * height < area)
+        grow();
+
+    positions.resize(sizes.size());
+    while (width <= maxSize && height <= maxSize) {
+        auto packer = AtlasPacker::Create(width, height);
+        bool packed = true;
+        for (size_t index : order) {
+            auto& position = positions[index];
+            if (!packer->Insert(sizes[index].x + padding * 2, sizes[index].y + padding * 2,
+                position.x, position.y)) {
+                packed = false;
+                break;
+            }
+        }
+        if (packed) {
+            // 위쪽 빈 공간은 잘라낸다 (mip 레벨이 나누어 떨어지도록 16의 배수)
+            height = std::min(height, (packer->GetUsedHeight() + 15) / 16 * 16);
+            return true;
+        }
+        grow();
+    }
+    return false;
+}
+
+ImageUPtr TextureAtlas::MakePaddedImage(const Image* image, int padding) {
+    // 채널 수 확장은 ImageOps에서 처리하고 여기서는 RGBA 픽셀만 복사
+    auto rgba = ImageOps::ExpandToRgba(image);
+    if (!rgba || padding == 0)
+        return std::move(rgba);
+    int srcWidth = rgba->GetWidth();
+    int srcHeight = rgba->GetHeight();
+    auto padded = Image::Create(srcWidth + padding * 2, srcHeight + padding * 2, 4);
+    if (!padded)
+        return nullptr;
+
+    // 바깥 픽셀은 가장 가까운 가장자리 픽셀을 복제 (clamp to edge와 같은 결과)
+    const uint8_t* src = rgba->GetData();
+    uint8_t* dst = padded->GetData();
+    int width = padded->GetWidth();
+    for (int j = 0; j < padded->GetHeight(); j++) {
+        int y = std::clamp(j - padding, 0, srcHeight - 1);
+        const uint8_t* row = src + (size_t)y * srcWidth * 4;
+        uint8_t* out = dst + (size_t)j * width * 4;
+        for (int i = 0; i < padding; i++) {
+            memcpy(out + i * 4, row, 4);
+            memcpy(out + (padding + srcWidth + i) * 4, row + (srcWidth - 1) * 4, 4);
+        }
+        memcpy(out + padding * 4, row, (size_t)srcWidth * 4);
+    }
+    return std::move(padded);
+}
+
+bool TextureAtlas::InitAtlas(const std::vector<const Image*>& images, int maxSize, int padding) {
+    PROFILE_SCOPE("TextureAtlas::InitAtlas");
+    if (images.empty()) {
+        SPDLOG_ERROR("no image to pack");
+        return false;
+    }
+    std::vector<glm::ivec2> sizes;
+    for (auto image : images)
+        sizes.push_back(glm::ivec2(image->GetWidth(), image->GetHeight()));
+    std::vector<glm::ivec2> positions;
+    int width = 0;
+    int height = 0;
+    if (!Pack(sizes, maxSize, padding, width, height, positions)) {
+        SPDLOG_ERROR("failed to pack {} images into {}x{} atlas", images.size(), maxSize, maxSize);
+        return false;
+    }
+
+    /*
+        레벨 L의 texel 하나는 원본 2^L x 2^L 블록의 평균이고, bilinear 샘플링은 이웃 texel을 하나 더 읽는다
+        이미지 가장자리에서 최대 2^(L + 1) - 1 픽셀 바깥까지 섞이므로
+        그 범위가 padding 안에 들어오는 레벨까지만 사용 (padding 8 -> 레벨 2까지)
+    */
+    int maxLevel = 0;
+    while ((4 << maxLevel) - 1 <= padding)
+        maxLevel++;
+    m_texture = Texture::Create(width, height, GL_RGBA, maxLevel + 1);
+    m_texture->SetFilter(maxLevel > 0 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR, GL_LINEAR);
+
+    // 업로드하지 않는 빈 영역은 정의되지 않으므로 padding 포함 영역만 샘플링되어야 한다
+    uint64_t imageArea = 0;
+    for (size_t i = 0; i < images.size(); i++) {
+        auto padded = MakePaddedImage(images[i], padding);
+        if (!padded)
+            return false;
+        m_texture->UpdateRegion(positions[i].x, positions[i].y,
+            padded->GetWidth(), padded->GetHeight(), padded->GetData());
+
+        AtlasRegion region;
+        region.uvOffset = glm::vec2((float)(positions[i].x + padding) / width,
+            (float)(positions[i].y + padding) / height);
+        region.uvScale = glm::vec2((float)sizes[i].x / width, (float)sizes[i].y / height);
+        m_regions.push_back(region);
+        imageArea += (uint64_t)sizes[i].x * sizes[i].y;
+    }
+    if (maxLevel > 0)
+        m_texture->GenerateMipmap();
+
+    m_efficiency = 100.0f * (float)imageArea / ((float)width * height);
+    SPDLOG_INFO("texture atlas: {} images, {}x{}, {} mip levels, efficiency {:.1f}%",
+        images.size(), width, height, maxLevel + 1, m_efficiency);
+    return true;
+}
+
+bool TextureAtlas::InitArray(const std::vector<const Image*>& images) {
+    PROFILE_SCOPE("TextureAtlas::InitArray");
+    if (images.empty()) {
+        SPDLOG_ERROR("no image to pack");
+        return false;
+    }
+    int width = images[0]->GetWidth();
+    int height = images[0]->GetHeight();
+    int layerCount = (int)images.size();
+    for (auto image : images) {
+        if (image->GetWidth() != width || image->GetHeight() != height) {
+            SPDLOG_ERROR("texture array layers must have the same size: {}x{} != {}x{}",
+                image->GetWidth(), image->GetHeight(), width, height);
+            return false;
+        }
+    }
+
+    // layer끼리는 섞이지 않으므로 전체 mip chain 사용
+    int levelCount = 1;
+    while ((std::max(width, height) >> levelCount) > 0)
+        levelCount++;
+    m_texture = Texture::CreateArray(width, height, layerCount, GL_RGBA, levelCount);
+    for (int layer = 0; layer < layerCount; layer++) {
+        // padding 없이 RGBA 변환만
+        auto rgba = MakePaddedImage(images[layer], 0);
+        if (!rgba)
+            return false;
+        m_texture->UpdateLayer(layer, rgba->GetData());
+        AtlasRegion region;
+        region.layer = (uint32_t)layer;
+        m_regions.push_back(region);
+    }
+    m_texture->GenerateMipmap();
+
+    m_efficiency = 100.0f;
+    SPDLOG_INFO("texture array: {} layers, {}x{}", layerCount, width, height);
+    return true;
+}
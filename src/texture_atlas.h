@@ -0,0 +1,63 @@
+#ifndef __TEXTURE_ATLAS_H__
+#define __TEXTURE_ATLAS_H__
+
+#include "texture.h"
+#include "atlas_packer.h"
+
+// atlas 안의 이미지 하나의 위치. shader에서 uv * uvScale + uvOffset, layer로 샘플링
+// 기본 값은 텍스처 전체 (atlas에 넣지 않은 일반 텍스처에도 그대로 사용)
+struct AtlasRegion {
+    glm::vec2 uvOffset { 0.0f };
+    glm::vec2 uvScale { 1.0f };
+    uint32_t layer { 0 };
+};
+
+/*
+    여러 개의 작은 이미지를 텍스처 하나로 합쳐 재질이 달라도 같은 텍스처를 바인딩하게 한다
+    - Atlas: GL_TEXTURE_2D 하나에 skyline packing. 이미지 둘레에 가장자리 픽셀을
+      padding 만큼 복제해 두고, mip 레벨은 샘플링 범위가 padding을 넘지 않는 곳까지만 사용하여
+      이웃 이미지가 번지지 않게 한다
+    - Array: 같은 크기의 이미지를 GL_TEXTURE_2D_ARRAY의 layer로 쌓는다. 번짐이 없고 uv 변환도 필요 없음
+    모든 이미지는 RGBA8로 올린다
+*/
+CLASS_PTR(TextureAtlas)
+class TextureAtlas {
+public:
+    static TextureAtlasUPtr CreateAtlas(const std::vector<const Image*>& images,
+        int maxSize = 4096, int padding = 8);
+    static TextureAtlasUPtr CreateArray(const std::vector<const Image*>& images);
+
+    // GL_TEXTURE_2D 또는 GL_TEXTURE_2D_ARRAY 텍스처
+    const TexturePtr& GetTexture() const { return m_texture; }
+    uint32_t Get() const { return m_texture->Get(); }
+    uint32_t GetTarget() const { return m_texture->GetTarget(); }
+    void Bind(uint32_t unit) const { m_texture->Bind(unit); }
+
+    int GetWidth() const { return m_texture->GetWidth(); }
+    int GetHeight() const { return m_texture->GetHeight(); }
+    int GetLayerCount() const { return m_texture->GetLayerCount(); }
+    size_t GetRegionCount() const { return m_regions.size(); }
+    // 입력 images와 같은 순서
+    const AtlasRegion& GetRegion(size_t index) const { return m_regions[index]; }
+    // padding을 뺀 이미지 픽셀 넓이 / 텍스처 전체 넓이 (%)
+    float GetEfficiency() const { return m_efficiency; }
+
+    // sizes를 padding 포함하여 담을 수 있는 가장 작은 2의 거듭제곱 크기를 찾아 배치하고
+    // 사용하지 않은 위쪽은 잘라낸다
+    // positions는 padding을 포함한 사각형의 위치. maxSize 안에 들어가지 않으면 false
+    static bool Pack(const std::vector<glm::ivec2>& sizes, int maxSize, int padding,
+        int& width, int& height, std::vector<glm::ivec2>& positions);
+    // 가장자리를 padding만큼 복제한 RGBA 이미지
+    static ImageUPtr MakePaddedImage(const Image* image, int padding);
+
+private:
+    TextureAtlas() {}
+    bool InitAtlas(const std::vector<const Image*>& images, int maxSize, int padding);
+    bool InitArray(const std::vector<const Image*>& images);
+
+    TexturePtr m_texture;
+    float m_efficiency { 0.0f };
+    std::vector<AtlasRegion> m_regions;
+};
+
+#endif // __TEXTURE_ATLAS_H__
@@ -0,0 +1,152 @@
+#include "texture_cache.h"
+#include "profiler.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+static constexpr uint32_t kTextureCacheMagic = 0x48435854; // "TXCH"
+static constexpr uint32_t kTextureCacheVersion = 2;
+
+TextureCacheUPtr TextureCache::Create(const std::string& directory) {
+    auto cache = TextureCacheUPtr(new TextureCache());
+    if (!cache->Init(directory))
+        return nullptr;
+    return std::move(cache);
+}
+
+bool TextureCache::Init(const std::string& directory) {
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec) {
+        SPDLOG_ERROR("failed to create texture cache directory: {}", directory);
+        return false;
+    }
+    m_directory = directory;
+    return true;
+}
+
+std::string TextureCache::GetCachePath(const std::string& filepath) const {
+    return fmt::format("{}/{:016x}.texcache", m_directory, HashString(filepath));
+}
+
+CachedTextureUPtr TextureCache::Load(const std::string& filepath) const {
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (!GetFileStamp(filepath, sourceSize, sourceTime))
+        return nullptr;
+
+    auto cachePath = GetCachePath(filepath);
+    std::error_code ec;
+    if (!fs::exists(cachePath, ec))
+        return nullptr;
+    auto file = MappedFile::Open(cachePath);
+    if (!file || file->GetSize() < sizeof(TextureCacheHeader))
+        return nullptr;
+
+    auto header = (const TextureCacheHeader*)file->GetData();
+    if (header->magic != kTextureCacheMagic ||
+        header->version != kTextureCacheVersion ||
+        header->sourceSize != sourceSize ||
+        header->sourceTime != sourceTime)
+        return nullptr;
+
+    // 헤더 값으로 업로드 크기 / 포맷을 정하므로 손상된 파일이 mmap 밖을 읽지 않도록 모두 확인한다
+    int maxLevelCount = 1;
+    while (header->width > 0 && header->height > 0 &&
+        (std::max(header->width, header->height) >> maxLevelCount) > 0)
+        maxLevelCount++;
+    uint64_t fileSize = file->GetSize();
+    if (header->width <= 0 || header->height <= 0 ||
+        header->channelCount < 1 || header->channelCount > 4 ||
+        header->levelCount <= 0 || header->levelCount > maxLevelCount ||
+        fileSize < sizeof(TextureCacheHeader) + sizeof(TextureCacheLevel) * header->levelCount) {
+        SPDLOG_ERROR("corrupted texture cache: {}", cachePath);
+        return nullptr;
+    }
+
+    auto texture = CachedTextureUPtr(new CachedTexture());
+    texture->m_channelCount = header->channelCount;
+    auto levels = (const TextureCacheLevel*)(file->GetData() + sizeof(TextureCacheHeader));
+    int width = header->width;
+    int height = header->height;
+    for (int i = 0; i < header->levelCount; i++) {
+        auto& level = levels[i];
+        // 각 레벨은 이전 레벨의 절반 크기 (최소 1). offset + size는 overflow가 없도록 뺄셈으로 비교
+        if (i > 0) {
+            width = std::max(width / 2, 1);
+            height = std::max(height / 2, 1);
+        }
+        if (level.width != width || level.height != height ||
+            level.size != (uint64_t)width * height * header->channelCount ||
+            level.offset > fileSize || level.size > fileSize - level.offset) {
+            SPDLOG_ERROR("corrupted texture cache: {} (level {})", cachePath, i);
+            return nullptr;
+        }
+        texture->m_levels.push_back({ level.width, level.height,
+            file->GetData() + level.offset, (size_t)level.size });
+    }
+    texture->m_file = std::move(file);
+    return std::move(texture);
+}
+
+bool TextureCache::Store(const std::string& filepath, const Image* image) const {
+    PROFILE_SCOPE("TextureCache::Store");
+    TextureCacheHeader header = {};
+    header.magic = kTextureCacheMagic;
+    header.version = kTextureCacheVersion;
+    if (!GetFileStamp(filepath, header.sourceSize, header.sourceTime))
+        return false;
+    header.width = image->GetWidth();
+    header.height = image->GetHeight();
+    header.channelCount = image->GetChannelCount();
+
+    // CPU에서 mip chain을 미리 만들어 둔다 (1x1 까지)
+    std::vector<ImageUPtr> mips;
+    const Image* current = image;
+    while (current->GetWidth() > 1 || current->GetHeight() > 1) {
+        mips.push_back(current->Downsample());
+        current = mips.back().get();
+    }
+    header.levelCount = (int32_t)mips.size() + 1;
+
+    std::vector<TextureCacheLevel> levels;
+    uint64_t offset = sizeof(TextureCacheHeader) + sizeof(TextureCacheLevel) * header.levelCount;
+    for (int i = 0; i < header.levelCount; i++) {
+        const Image* level = i == 0 ? image : mips[i - 1].get();
+        uint64_t size = (uint64_t)level->GetWidth() * level->GetHeight() * level->GetChannelCount();
+        levels.push_back({ offset, size, level->GetWidth(), level->GetHeight() });
+        offset += size;
+    }
+
+    // 쓰는 도중 다른 thread가 읽지 않도록 임시 파일에 쓴 뒤 이름을 바꾼다
+    auto cachePath = GetCachePath(filepath);
+    auto tempPath = fmt::format("{}.{}.tmp", cachePath, std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream fout(tempPath, std::ios::binary);
+        if (!fout.is_open()) {
+            SPDLOG_ERROR("failed to write texture cache: {}", tempPath);
+            return false;
+        }
+        fout.write((const char*)&header, sizeof(header));
+        fout.write((const char*)levels.data(), sizeof(TextureCacheLevel) * levels.size());
+        for (int i = 0; i < header.levelCount; i++) {
+            const Image* level = i == 0 ? image : mips[i - 1].get();
+            fout.write((const char*)level->GetData(), levels[i].size);
+        }
+        if (!fout.good()) {
+            SPDLOG_ERROR("failed to write texture cache: {}", tempPath);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        SPDLOG_ERROR("failed to write texture cache: {}", cachePath);
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef __TEXTURE_CACHE_H__
+#define __TEXTURE_CACHE_H__
+
+#include "image.h"
+#include "mapped_file.h"
+
+/*
+    디코딩 및 mipmap 생성이 끝난 텍스처를 저장해두는 디스크 캐시
+    파일 구조: TextureCacheHeader | TextureCacheLevel * levelCount | 각 레벨의 raw 픽셀
+    원본 파일의 크기 / 수정 시간이 헤더와 다르면 캐시를 무효로 본다
+*/
+struct TextureCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    int32_t width;
+    int32_t height;
+    int32_t channelCount;
+    int32_t levelCount;
+};
+
+struct TextureCacheLevel {
+    uint64_t offset;
+    uint64_t size;
+    int32_t width;
+    int32_t height;
+};
+
+// mmap된 캐시 파일. 레벨별 픽셀 데이터를 복사 없이 바로 업로드할 수 있다
+CLASS_PTR(CachedTexture)
+class CachedTexture {
+public:
+    struct Level {
+        int width;
+        int height;
+        const uint8_t* data;
+        size_t size;
+    };
+
+    int GetWidth() const { return m_levels[0].width; }
+    int GetHeight() const { return m_levels[0].height; }
+    int GetChannelCount() const { return m_channelCount; }
+    int GetLevelCount() const { return (int)m_levels.size(); }
+    const Level& GetLevel(int level) const { return m_levels[level]; }
+
+private:
+    friend class TextureCache;
+    CachedTexture() {}
+    MappedFileUPtr m_file;
+    int m_channelCount { 0 };
+    std::vector<Level> m_levels;
+};
+
+CLASS_PTR(TextureCache)
+class TextureCache {
+public:
+    static TextureCacheUPtr Create(const std::string& directory);
+
+    // 여러 thread에서 동시에 호출할 수 있다
+    CachedTextureUPtr Load(const std::string& filepath) const;
+    bool Store(const std::string& filepath, const Image* image) const;
+
+private:
+    TextureCache() {}
+    bool Init(const std::string& directory);
+    std::string GetCachePath(const std::string& filepath) const;
+    std::string m_directory;
+};
+
+#endif // __TEXTURE_CACHE_H__
@@ -0,0 +1,130 @@
+#include "texture_loader.h"
+#include "image_ops.h"
+#include <algorithm>
+
+TextureLoaderUPtr TextureLoader::Create(size_t threadCount,
+    const std::string& cacheDirectory) {
+    auto loader = TextureLoaderUPtr(new TextureLoader());
+    if (!loader->Init(threadCount, cacheDirectory))
+        return nullptr;
+    return std::move(loader);
+}
+
+bool TextureLoader::Init(size_t threadCount, const std::string& cacheDirectory) {
+    // 디렉토리를 비워두거나 만들 수 없으면 캐시 없이 동작
+    if (!cacheDirectory.empty())
+        m_cache = TextureCache::Create(cacheDirectory);
+    m_threadPool = ThreadPool::Create(threadCount);
+    m_streamer = TextureStreamer::Create();
+    if (!m_streamer)
+        return false;
+    m_placeholder = Image::Create(64, 64);
+    if (!m_placeholder)
+        return false;
+    m_placeholder->SetCheckImage(8, 8);
+    SPDLOG_INFO("texture loader: {} threads", m_threadPool->GetThreadCount());
+    return true;
+}
+
+std::future<ImageUPtr> TextureLoader::LoadImageAsync(const std::string& filepath) {
+    return m_threadPool->Submit([filepath]() {
+        return Image::Load(filepath);
+    });
+}
+
+TexturePtr TextureLoader::Load(const std::string& filepath) {
+    TexturePtr texture = Texture::CreateFromImage(m_placeholder.get());
+    m_loaded.push_back({ filepath, NormalizePath(filepath), texture, texture.get() });
+    SubmitLoad(filepath, texture, 0);
+    return texture;
+}
+
+size_t TextureLoader::Reload(const std::vector<std::string>& changedFiles) {
+    size_t reloadCount = 0;
+    for (auto it = m_loaded.begin(); it != m_loaded.end();) {
+        auto texture = it->texture.lock();
+        if (!texture) {
+            it = m_loaded.erase(it);
+            continue;
+        }
+        if (std::find(changedFiles.begin(), changedFiles.end(), it->normalizedPath) != changedFiles.end()) {
+            SPDLOG_INFO("texture reload: {}", it->filepath);
+            SubmitLoad(it->filepath, texture, ++it->generation);
+            reloadCount++;
+        }
+        ++it;
+    }
+    return reloadCount;
+}
+
+std::vector<std::string> TextureLoader::GetSourceFiles() const {
+    std::vector<std::string> files;
+    for (auto& loaded : m_loaded) {
+        if (!loaded.texture.expired())
+            files.push_back(loaded.filepath);
+    }
+    return files;
+}
+
+bool TextureLoader::IsLatest(const Texture* texture, uint32_t generation) const {
+    for (auto& loaded : m_loaded) {
+        // 해제된 텍스처의 주소는 재사용될 수 있으므로 살아있는 항목만 비교
+        if (loaded.key == texture && !loaded.texture.expired())
+            return loaded.generation == generation;
+    }
+    return true;
+}
+
+void TextureLoader::SubmitLoad(const std::string& filepath, TexturePtr texture, uint32_t generation) {
+    auto cache = m_cache.get();
+    auto result = m_threadPool->Submit([filepath, cache]() {
+        LoadResult result;
+        if (cache) {
+            result.cached = cache->Load(filepath);
+            if (result.cached)
+                return result;
+        }
+        result.image = Image::Load(filepath);
+        // 업로드 포맷이 항상 GL_RGBA가 되도록 worker에서 미리 확장
+        if (result.image && result.image->GetChannelCount() != 4)
+            result.image = ImageOps::ExpandToRgba(result.image.get());
+        return result;
+    });
+    m_pending.push_back({ filepath, std::move(result), std::move(texture), generation });
+}
+
+size_t TextureLoader::Update() {
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        auto result = it->result.get();
+        // 파일이 다시 바뀌어 더 최근 요청이 있으면 늦게 끝난 이전 결과로 덮어쓰지 않는다
+        if (!IsLatest(it->texture.get(), it->generation)) {
+            SPDLOG_INFO("texture load superseded: {}", it->filepath);
+            it = m_pending.erase(it);
+            continue;
+        }
+        // 캐시 / 디코딩 결과 모두 스트리머의 예산 안에서 여러 프레임에 나누어 업로드
+        if (result.cached) {
+            m_streamer->Enqueue(it->texture, std::move(result.cached));
+        }
+        // 디코딩에 실패하면 기존 이미지(처음 로딩이면 placeholder)를 그대로 사용
+        else if (result.image) {
+            ImagePtr image = std::move(result.image);
+            SPDLOG_INFO("texture decoded: {} ({}x{}, {} channels)", it->filepath,
+                image->GetWidth(), image->GetHeight(), image->GetChannelCount());
+            m_streamer->Enqueue(it->texture, image);
+            // 캐시 파일은 업로드와 별개로 worker에서 기록. 다음 실행부터 사용된다
+            if (m_cache) {
+                auto cache = m_cache.get();
+                m_threadPool->Submit([filepath = it->filepath, cache, image]() {
+                    cache->Store(filepath, image.get());
+                });
+            }
+        }
+        it = m_pending.erase(it);
+    }
+    return m_streamer->Update();
+}
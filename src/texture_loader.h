@@ -0,0 +1,71 @@
+#ifndef __TEXTURE_LOADER_H__
+#define __TEXTURE_LOADER_H__
+
+#include "texture.h"
+#include "thread_pool.h"
+#include "texture_streamer.h"
+
+/*
+    이미지 디코딩은 thread pool에서 병렬로 수행하고
+    GPU 업로드는 GL thread에서 Update() 호출 시 몇 개씩 나누어 처리한다.
+    Load()는 바로 체크 무늬 placeholder 텍스처를 돌려주며
+    디코딩이 끝난 이미지는 TextureStreamer를 통해 여러 프레임에 나누어 올라간다.
+    업로드가 끝나면 같은 Texture 객체가 실제 이미지로 교체된다.
+    디스크 캐시가 있으면 디코딩 대신 캐시 파일을 mmap 하여 mip chain을 같은 방식으로 업로드하고,
+    캐시가 없던 이미지는 업로드와 별개로 worker에서 캐시 파일을 기록한다.
+*/
+CLASS_PTR(TextureLoader)
+class TextureLoader {
+public:
+    // cacheDirectory가 비어있으면 디스크 캐시를 사용하지 않는다
+    static TextureLoaderUPtr Create(size_t threadCount = 0,
+        const std::string& cacheDirectory = "./cache/texture");
+
+    std::future<ImageUPtr> LoadImageAsync(const std::string& filepath);
+    TexturePtr Load(const std::string& filepath);
+    // 변경된 파일(NormalizePath 형식)로 만든 텍스처를 다시 읽는다. 로딩 중에는 기존 이미지를 유지하고
+    // 디코딩에 실패하면 그대로 둔다. 다시 읽기 시작한 텍스처 개수를 반환
+    size_t Reload(const std::vector<std::string>& changedFiles);
+    // 지금까지 Load()한 파일 중 텍스처가 아직 살아 있는 것
+    std::vector<std::string> GetSourceFiles() const;
+
+    // GL thread에서 호출. 업로드가 완료된 텍스처 개수를 돌려준다
+    size_t Update();
+    size_t GetPendingCount() const { return m_pending.size() + m_streamer->GetPendingCount(); }
+    TextureStreamer* GetStreamer() const { return m_streamer.get(); }
+
+private:
+    TextureLoader() {}
+    bool Init(size_t threadCount, const std::string& cacheDirectory);
+    void SubmitLoad(const std::string& filepath, TexturePtr texture, uint32_t generation);
+    // 같은 텍스처를 다시 읽기 시작했으면 이전 요청의 결과는 버린다
+    bool IsLatest(const Texture* texture, uint32_t generation) const;
+
+    // 캐시 적중 시 cached, 아니면 디코딩한 image 중 하나가 채워진다
+    struct LoadResult {
+        ImageUPtr image;
+        CachedTextureUPtr cached;
+    };
+    struct PendingTexture {
+        std::string filepath;
+        std::future<LoadResult> result;
+        TexturePtr texture;
+        uint32_t generation;
+    };
+    // worker thread가 참조하므로 thread pool보다 먼저 선언 (나중에 해제)
+    TextureCacheUPtr m_cache;
+    ThreadPoolUPtr m_threadPool;
+    TextureStreamerUPtr m_streamer;
+    ImageUPtr m_placeholder;
+    std::vector<PendingTexture> m_pending;
+    struct LoadedTexture {
+        std::string filepath;
+        std::string normalizedPath;
+        TextureWPtr texture;
+        const Texture* key;      // texture가 해제된 뒤에도 비교할 수 있는 주소
+        uint32_t generation { 0 }; // 읽기를 시작할 때마다 증가
+    };
+    std::vector<LoadedTexture> m_loaded;
+};
+
+#endif // __TEXTURE_LOADER_H__
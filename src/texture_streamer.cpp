@@ -0,0 +1,119 @@
+#include "texture_streamer.h"
+#include "profiler.h"
+#include "render_state.h"
+#include <cstring>
+
+TextureStreamerUPtr TextureStreamer::Create(size_t bufferSize, size_t bufferCount) {
+    auto streamer = TextureStreamerUPtr(new TextureStreamer());
+    if (!streamer->Init(bufferSize, bufferCount))
+        return nullptr;
+    return std::move(streamer);
+}
+
+bool TextureStreamer::Init(size_t bufferSize, size_t bufferCount) {
+    m_bufferSize = bufferSize;
+    for (size_t i = 0; i < bufferCount; i++) {
+        auto buffer = Buffer::CreateWithData(
+            GL_PIXEL_UNPACK_BUFFER, GL_STREAM_DRAW, nullptr, bufferSize);
+        if (!buffer)
+            return false;
+        m_buffers.push_back(std::move(buffer));
+    }
+    RenderState::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
+void TextureStreamer::Enqueue(TexturePtr target, ImagePtr image) {
+    StreamJob job;
+    job.staging = Texture::Create(image->GetWidth(), image->GetHeight(),
+        Texture::GetImageFormat(image->GetChannelCount()));
+    job.target = std::move(target);
+    job.image = std::move(image);
+    m_jobs.push_back(std::move(job));
+}
+
+void TextureStreamer::Enqueue(TexturePtr target, CachedTextureUPtr cached) {
+    StreamJob job;
+    job.staging = Texture::Create(cached->GetWidth(), cached->GetHeight(),
+        Texture::GetImageFormat(cached->GetChannelCount()), cached->GetLevelCount());
+    job.target = std::move(target);
+    job.cached = std::move(cached);
+    m_jobs.push_back(std::move(job));
+}
+
+size_t TextureStreamer::Update() {
+    PROFILE_SCOPE("TextureStreamer::Update");
+    PROFILE_GPU_SCOPE("TextureStreamer::Update");
+    size_t completeCount = 0;
+    size_t budget = m_frameBudget;
+    m_lastFrameUploadSize = 0;
+
+    while (!m_jobs.empty() && budget > 0) {
+        auto& job = m_jobs.front();
+        // 이번에 올릴 레벨의 픽셀
+        int width, height, channelCount;
+        const uint8_t* data;
+        if (job.cached) {
+            auto& level = job.cached->GetLevel(job.level);
+            width = level.width;
+            height = level.height;
+            channelCount = job.cached->GetChannelCount();
+            data = level.data;
+        }
+        else {
+            width = job.image->GetWidth();
+            height = job.image->GetHeight();
+            channelCount = job.image->GetChannelCount();
+            data = job.image->GetData();
+        }
+        size_t rowSize = (size_t)width * channelCount;
+        int rowsLeft = height - job.nextRow;
+
+        // 예산과 PBO 크기 안에서 올릴 수 있는 행 수. 최소 한 행은 진행
+        size_t rowLimit = std::min(budget, m_bufferSize) / rowSize;
+        int rowCount = std::min(rowsLeft, (int)std::max<size_t>(rowLimit, 1));
+        size_t chunkSize = rowSize * rowCount;
+        if (chunkSize > m_bufferSize) {
+            // PBO보다 큰 행은 클라이언트 메모리에서 직접 업로드
+            job.staging->UpdateRegion(0, job.nextRow, width, rowCount,
+                data + rowSize * job.nextRow, job.level);
+        }
+        else {
+            // 다음 PBO를 invalidate 하여 map하므로 GPU가 이전 내용을 읽는 중이어도 대기하지 않음
+            auto& buffer = m_buffers[m_bufferIndex];
+            m_bufferIndex = (m_bufferIndex + 1) % m_buffers.size();
+            void* ptr = buffer->Map(0, chunkSize,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (!ptr) {
+                SPDLOG_ERROR("failed to map pixel unpack buffer");
+                RenderState::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                break;
+            }
+            memcpy(ptr, data + rowSize * job.nextRow, chunkSize);
+            buffer->Unmap();
+            // PBO가 바인딩된 상태이므로 data 인자는 버퍼 내 offset
+            job.staging->UpdateRegion(0, job.nextRow, width, rowCount, nullptr, job.level);
+            RenderState::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        job.nextRow += rowCount;
+        budget -= std::min(budget, chunkSize);
+        m_lastFrameUploadSize += chunkSize;
+        Profiler::Get().AddCounter(ProfileCounter::TextureUploadBytes, chunkSize);
+
+        if (job.nextRow < height)
+            continue;
+        // 캐시된 mip chain은 다음 레벨로 진행
+        if (job.cached && job.level + 1 < job.cached->GetLevelCount()) {
+            job.level++;
+            job.nextRow = 0;
+            continue;
+        }
+        if (!job.cached)
+            job.staging->GenerateMipmap();
+        job.target->Swap(*job.staging);
+        m_jobs.pop_front();
+        completeCount++;
+    }
+    return completeCount;
+}
@@ -0,0 +1,52 @@
+#ifndef __TEXTURE_STREAMER_H__
+#define __TEXTURE_STREAMER_H__
+
+#include "texture.h"
+#include "buffer.h"
+#include <deque>
+
+/*
+    큰 텍스처를 여러 프레임에 나누어 업로드하는 스트리머
+    GL_PIXEL_UNPACK_BUFFER(PBO) 여러 개를 돌려가며 사용하고
+    프레임당 업로드할 byte 양을 제한하여 frame time spike를 막는다.
+    업로드는 별도의 staging 텍스처에 진행되며, 완료되면 대상 텍스처와 교체된다.
+    이미지는 level 0만 올린 뒤 GPU에서 mipmap을 만들고, 캐시된 텍스처는 mip chain을 레벨 순서로 올린다.
+*/
+CLASS_PTR(TextureStreamer)
+class TextureStreamer {
+public:
+    static TextureStreamerUPtr Create(
+        size_t bufferSize = 4 * 1024 * 1024, size_t bufferCount = 3);
+
+    void SetFrameBudget(size_t byteCount) { m_frameBudget = byteCount; }
+    size_t GetFrameBudget() const { return m_frameBudget; }
+
+    void Enqueue(TexturePtr target, ImagePtr image);
+    void Enqueue(TexturePtr target, CachedTextureUPtr cached);
+    // GL thread에서 프레임마다 호출. 업로드가 끝난 텍스처 개수를 돌려준다
+    size_t Update();
+    size_t GetPendingCount() const { return m_jobs.size(); }
+    size_t GetLastFrameUploadSize() const { return m_lastFrameUploadSize; }
+
+private:
+    TextureStreamer() {}
+    bool Init(size_t bufferSize, size_t bufferCount);
+
+    struct StreamJob {
+        TexturePtr target;
+        TextureUPtr staging;
+        // image / cached 중 하나
+        ImagePtr image;
+        CachedTextureUPtr cached;
+        int level { 0 };
+        int nextRow { 0 };
+    };
+    std::vector<BufferUPtr> m_buffers;
+    size_t m_bufferIndex { 0 };
+    size_t m_bufferSize { 0 };
+    size_t m_frameBudget { 2 * 1024 * 1024 };
+    size_t m_lastFrameUploadSize { 0 };
+    std::deque<StreamJob> m_jobs;
+};
+
+#endif // __TEXTURE_STREAMER_H__
@@ -0,0 +1,41 @@
+#include "thread_pool.h"
+
+ThreadPoolUPtr ThreadPool::Create(size_t threadCount) {
+    auto threadPool = ThreadPoolUPtr(new ThreadPool());
+    threadPool->Init(threadCount);
+    return std::move(threadPool);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void ThreadPool::Init(size_t threadCount) {
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    m_workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++)
+        m_workers.emplace_back([this]() { WorkerLoop(); });
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+            // 종료 요청이 와도 남은 작업은 모두 처리한 뒤 끝낸다
+            if (m_stop && m_tasks.empty())
+                return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
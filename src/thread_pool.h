@@ -0,0 +1,50 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include "common.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <queue>
+
+/*
+    고정 개수의 worker thread가 작업 큐를 처리하는 thread pool
+    Submit은 작업 결과를 std::future로 돌려준다
+*/
+CLASS_PTR(ThreadPool)
+class ThreadPool {
+public:
+    // threadCount가 0이면 하드웨어 스레드 개수만큼 생성
+    static ThreadPoolUPtr Create(size_t threadCount = 0);
+    ~ThreadPool();
+
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+    template <typename F>
+    auto Submit(F&& func) -> std::future<decltype(func())> {
+        using ResultType = decltype(func());
+        auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(func));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push([task]() { (*task)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+
+private:
+    ThreadPool() {}
+    void Init(size_t threadCount);
+    void WorkerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stop { false };
+};
+
+#endif // __THREAD_POOL_H__
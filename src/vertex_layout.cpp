@@ -1,4 +1,5 @@
 #include "vertex_layout.h"
+#include "render_state.h"
 
 VertexLayoutUPtr VertexLayout::Create() {
     auto vertexLayout = VertexLayoutUPtr(new VertexLayout());
@@ -8,12 +9,13 @@ VertexLayoutUPtr VertexLayout::Create() {
 
 VertexLayout::~VertexLayout() {
     if (m_vertexArrayObject) {
+        RenderState::Get().ForgetVertexArray(m_vertexArrayObject);
         glDeleteVertexArrays(1, &m_vertexArrayObject);
     }
 }
 
 void VertexLayout::Bind() const {
-    glBindVertexArray(m_vertexArrayObject);
+    RenderState::Get().BindVertexArray(m_vertexArrayObject);
 }
 
 void VertexLayout::SetAttrib(
@@ -33,6 +35,21 @@ void VertexLayout::SetAttrib(
         type, normalized, stride, (const void*)offset);
 }
 
+void VertexLayout::SetAttribDivisor(uint32_t attribIndex, uint32_t divisor) const {
+    // divisor는 VAO 상태이므로 이 VAO에 기록되도록 먼저 바인딩
+    Bind();
+    /*
+        divisor: 몇 개의 인스턴스마다 attribute 값을 다음 값으로 넘길 것인가
+        0이면 정점마다, 1이면 인스턴스마다 갱신 (instanced rendering)
+    */
+    glVertexAttribDivisor(attribIndex, divisor);
+}
+
+void VertexLayout::DisableAttrib(int attribIndex) const {
+    Bind();
+    glDisableVertexAttribArray(attribIndex);
+}
+
 void VertexLayout::Init() {
     glGenVertexArrays(1, &m_vertexArrayObject);
     Bind();
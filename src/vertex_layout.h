@@ -15,6 +15,7 @@ public:
         uint32_t attribIndex, int count,
         uint32_t type, bool normalized,
         size_t stride, uint64_t offset) const;
+    void SetAttribDivisor(uint32_t attribIndex, uint32_t divisor) const;
     void DisableAttrib(int attribIndex) const;
 
 private: